@@ -3,6 +3,8 @@
  #include <future>
  #include <chrono>
 
+ #include "../../common/work_stealing_pool.hpp"
+
  /**
  * Step 4 - Multiple Concurrent Threads
  * Create three threads (A, B, C), each running a function that prints its thread name five times with a short delay between prints.
@@ -10,6 +12,13 @@
  * Ensure all threads are joined before the program exits.
  */
 
+/**
+ * Follow-on: each std::thread above is created and torn down for one call of
+ * say(). A WorkStealingPool starts its workers once and runs the same calls
+ * as submitted jobs; submit() takes the arguments like the std::thread
+ * constructor, and get() plays the role of join().
+ */
+
  void say (const char* name){
     using namespace std::chrono_literals;
 
@@ -25,4 +34,11 @@
     A.join(); 
     B.join(); 
     C.join();
+
+    parallel::WorkStealingPool pool(3);
+    auto a = pool.submit(say, "A"), b = pool.submit(say, "B"), c = pool.submit(say, "C");
+
+    a.get();
+    b.get();
+    c.get();
  }
\ No newline at end of file
@@ -0,0 +1,287 @@
+/**
+ * Contended-counter benchmark for step5's add_1000 workload.
+ *
+ * N threads each add 1 to one shared counter M times, with every increment
+ * synchronised by one of:
+ *   racy     - plain ++counter, no synchronisation (the "what happens?" run
+ *              of step5; a data race, shown only to expose lost updates)
+ *   mutex    - std::lock_guard<std::mutex> around ++counter (step5 as set)
+ *   atomic   - std::atomic<long long>::fetch_add
+ *   ttas     - parallel::TtasSpinLock
+ *   ticket   - parallel::TicketLock
+ *   mcs      - parallel::McsLock
+ *   adaptive - parallel::AdaptiveMutex (spin, then park on a futex)
+ *   striped  - parallel::StripedCounter (one cache line per thread, summed at the end)
+ * (parallel_reduce, which step5 now uses, is the striped counter taken to
+ * its limit: nothing shared until the end.)
+ *
+ * Per variant and thread count it reports:
+ *   ops_per_s - total increments per second (mean over trials)
+ *   jain      - Jain's fairness index of per-thread throughput (each thread's
+ *               M / its own finish time): 1.0 = every thread progressed at the
+ *               same rate, 1/N = one thread ran while the others waited
+ *   spread    - slowest thread's finish time / fastest thread's
+ *   correct   - the final count was N * M in every trial
+ * Threads are created before the clock starts and released together.
+ *
+ * Usage: ./step5-bench [--threads 1,2,4] [--increments 1000000]
+ *                      [--trials 3] [--format csv|json]
+ * Compile: g++ -std=c++20 -O2 -pthread step5-bench.cpp -o step5-bench
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <latch>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../common/adaptive_mutex.hpp"
+#include "../../common/spin_locks.hpp"
+#include "../../common/striped_counter.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+enum class Variant { Racy, Mutex, Atomic, Ttas, Ticket, Mcs, Adaptive, Striped };
+
+const char* variant_name(Variant v) {
+    switch (v) {
+        case Variant::Racy:    return "racy";
+        case Variant::Mutex:   return "mutex";
+        case Variant::Atomic:  return "atomic";
+        case Variant::Ttas:    return "ttas";
+        case Variant::Ticket:  return "ticket";
+        case Variant::Mcs:     return "mcs";
+        case Variant::Adaptive: return "adaptive";
+        case Variant::Striped: return "striped";
+    }
+    return "?";
+}
+
+struct Trial {
+    double seconds;
+    long long count;
+    std::vector<double> finish_s;   // per thread, from the common start
+};
+
+/**
+ * @brief The step5 loop, 'increments' times, with the given lock around ++counter.
+ */
+template <typename Lock>
+void locked_adds(Lock& lock, long long& counter, long long increments) {
+    for (long long i = 0; i < increments; ++i) {
+        std::lock_guard<Lock> guard(lock);
+        ++counter;
+    }
+}
+
+Trial run_trial(Variant variant, unsigned num_threads, long long increments) {
+    long long counter = 0;
+    std::atomic<long long> atomic_counter{0};
+    parallel::StripedCounter striped(num_threads);
+    std::mutex mutex;
+    parallel::TtasSpinLock ttas;
+    parallel::TicketLock ticket;
+    parallel::McsLock mcs;
+    parallel::AdaptiveMutex adaptive;
+
+    std::latch go(num_threads + 1);
+    std::vector<Clock::time_point> finished(num_threads);
+    std::vector<std::thread> threads;
+    Clock::time_point start;
+
+    for (unsigned t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            go.arrive_and_wait();
+            switch (variant) {
+                case Variant::Racy: {
+                    // volatile keeps the compiler from merging the adds into one
+                    volatile long long& racy = counter;
+                    for (long long i = 0; i < increments; ++i) {
+                        racy = racy + 1; // !!! DATA RACE !!!
+                    }
+                    break;
+                }
+                case Variant::Mutex:   locked_adds(mutex, counter, increments); break;
+                case Variant::Ttas:    locked_adds(ttas, counter, increments); break;
+                case Variant::Ticket:  locked_adds(ticket, counter, increments); break;
+                case Variant::Mcs:     locked_adds(mcs, counter, increments); break;
+                case Variant::Adaptive: locked_adds(adaptive, counter, increments); break;
+                case Variant::Atomic:
+                    for (long long i = 0; i < increments; ++i) {
+                        atomic_counter.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+                case Variant::Striped:
+                    for (long long i = 0; i < increments; ++i) {
+                        striped.add();
+                    }
+                    break;
+            }
+            finished[t] = Clock::now();
+        });
+    }
+
+    start = Clock::now();
+    go.arrive_and_wait();
+    for (auto& th : threads) {
+        th.join();
+    }
+    const auto end = Clock::now();
+
+    Trial trial{std::chrono::duration<double>(end - start).count(), 0, {}};
+    switch (variant) {
+        case Variant::Atomic:  trial.count = atomic_counter.load(); break;
+        case Variant::Striped: trial.count = striped.value(); break;
+        default:               trial.count = counter; break;
+    }
+    for (const auto& f : finished) {
+        trial.finish_s.push_back(std::chrono::duration<double>(f - start).count());
+    }
+    return trial;
+}
+
+struct Result {
+    Variant variant;
+    unsigned threads;
+    long long increments;
+    double mean_s;
+    double ops_per_s;
+    double jain;
+    double spread;
+    bool correct;
+};
+
+Result measure(Variant variant, unsigned threads, long long increments, int trials) {
+    run_trial(variant, threads, increments); // warm-up
+
+    Result r{variant, threads, increments, 0.0, 0.0, 0.0, 0.0, true};
+    for (int k = 0; k < trials; ++k) {
+        const Trial trial = run_trial(variant, threads, increments);
+        r.mean_s += trial.seconds;
+        r.correct = r.correct && trial.count == static_cast<long long>(threads) * increments;
+
+        // Jain's index over per-thread rates: (sum x)^2 / (n * sum x^2)
+        double sum = 0.0;
+        double sum_sq = 0.0;
+        for (const double f : trial.finish_s) {
+            const double rate = static_cast<double>(increments) / std::max(f, 1e-9);
+            sum += rate;
+            sum_sq += rate * rate;
+        }
+        r.jain += sum * sum / (static_cast<double>(threads) * sum_sq);
+        const auto [fastest, slowest] = std::minmax_element(trial.finish_s.begin(), trial.finish_s.end());
+        r.spread += *slowest / std::max(*fastest, 1e-9);
+    }
+    r.mean_s /= trials;
+    r.jain /= trials;
+    r.spread /= trials;
+    r.ops_per_s = static_cast<double>(threads) * static_cast<double>(increments) / r.mean_s;
+    return r;
+}
+
+// Comma-separated list of positive counts; empty if any entry is below 1
+std::vector<long long> parse_list(const std::string& arg) {
+    std::vector<long long> values;
+    std::stringstream ss(arg);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        const long long value = std::stoll(item);
+        if (value < 1) {
+            return {};
+        }
+        values.push_back(value);
+    }
+    return values;
+}
+
+void print_csv(const std::vector<Result>& results) {
+    std::cout << "variant,threads,increments,mean_s,ops_per_s,jain,spread,correct\n";
+    for (const auto& r : results) {
+        std::cout << variant_name(r.variant) << ',' << r.threads << ',' << r.increments << ','
+                  << std::setprecision(6) << r.mean_s << ','
+                  << std::setprecision(10) << r.ops_per_s << ','
+                  << std::setprecision(4) << r.jain << ',' << r.spread << ','
+                  << (r.correct ? "true" : "false") << '\n';
+    }
+}
+
+void print_json(const std::vector<Result>& results) {
+    std::cout << "[\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        std::cout << "  {\"variant\": \"" << variant_name(r.variant) << "\""
+                  << ", \"threads\": " << r.threads
+                  << ", \"increments\": " << r.increments
+                  << std::setprecision(6) << ", \"mean_s\": " << r.mean_s
+                  << std::setprecision(10) << ", \"ops_per_s\": " << r.ops_per_s
+                  << std::setprecision(4) << ", \"jain\": " << r.jain
+                  << ", \"spread\": " << r.spread
+                  << ", \"correct\": " << (r.correct ? "true" : "false") << "}"
+                  << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    std::cout << "]\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<long long> thread_counts;
+    std::vector<long long> increment_counts{1000000};
+    int trials = 3;
+    std::string format = "csv";
+    bool counts_ok = true;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        const std::string value = argv[i + 1];
+        if (flag == "--threads") {
+            thread_counts = parse_list(value);
+            counts_ok = counts_ok && !thread_counts.empty();
+        } else if (flag == "--increments") {
+            increment_counts = parse_list(value);
+            counts_ok = counts_ok && !increment_counts.empty();
+        } else if (flag == "--trials") {
+            trials = std::stoi(value);
+        } else if (flag == "--format") {
+            format = value;
+        } else {
+            std::cerr << "Unknown option " << flag << "\n";
+            return 1;
+        }
+    }
+    if (argc % 2 == 0 || trials < 1 || !counts_ok || (format != "csv" && format != "json")) {
+        std::cerr << "Usage: " << argv[0] << " [--threads 1,2,4] [--increments 1000000]"
+                  << " [--trials 3] [--format csv|json]\n";
+        return 1;
+    }
+    if (thread_counts.empty()) {
+        // Powers of two up to twice the core count, to include oversubscription
+        const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned n = 1; n <= 2 * hw; n *= 2) {
+            thread_counts.push_back(n);
+        }
+    }
+
+    const Variant variants[] = {Variant::Racy, Variant::Mutex, Variant::Atomic, Variant::Ttas,
+                                Variant::Ticket, Variant::Mcs, Variant::Adaptive, Variant::Striped};
+    std::vector<Result> results;
+    for (long long increments : increment_counts) {
+        for (Variant variant : variants) {
+            for (long long n : thread_counts) {
+                results.push_back(measure(variant, static_cast<unsigned>(n), increments, trials));
+            }
+        }
+    }
+
+    if (format == "json") {
+        print_json(results);
+    } else {
+        print_csv(results);
+    }
+    return 0;
+}
@@ -2,6 +2,9 @@
  #include <thread>
  #include <future>
  #include <chrono>
+ #include <functional>
+
+ #include "../../common/parallel_reduce.hpp"
 
   /**
   * Step 5 - Thread Synchronisation with std::mutex
@@ -10,18 +13,20 @@
   * Then add a std::mutex to protect the counter using lock_guard<std::mutex> so the result is correct.
   */
 
-int counter = 0;
-std::mutex m;
+/**
+ * Follow-on: guarding ++counter with lock_guard costs one lock/unlock per increment.
+ * With parallel_reduce each thread counts into its own cache-line-padded
+ * partial (nothing shared, so no lock and no data race) and the partials
+ * are added together once after the threads join.
+ */
 
-void add_1000() {
+void add_1000(unsigned /*thread_idx*/, int& counter) {
     for (int i = 0; i < 1000; ++i) {
-        std::lock_guard <std::mutex> lg(m);
         ++counter;
     }
 }
 
 int main() {
-    std::thread t1(add_1000), t2(add_1000);
-    t1.join(); t2.join();
-    std::cout << "counter =" << "(expected 2000)\n";
-}
\ No newline at end of file
+    const int counter = parallel::parallel_reduce(2, 0, std::plus<>{}, add_1000);
+    std::cout << "counter = " << counter << " (expected 2000)\n";
+}
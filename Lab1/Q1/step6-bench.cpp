@@ -0,0 +1,212 @@
+/**
+ * Yield and false-sharing experiment for step6.
+ *
+ * Two threads run step6's loop ('iterations' adds to a volatile sink): the
+ * "spin" thread never yields, the "yield" thread calls
+ * std::this_thread::yield() every 'yield_every' iterations (0 = never). Each
+ * configuration varies:
+ *   layout - padded:       each thread's sink on its own cache line
+ *            false-shared: two sinks next to each other in one cache line
+ *            shared:       both threads add to the same sink (step6 as set;
+ *                          the total is racy, which is not what is measured)
+ *   pin    - none:      the scheduler places the threads
+ *            same:      both threads pinned to CPU 0, so they time-share it
+ *                       and every yield can hand the CPU to the other
+ *            different: CPU 0 and CPU 1, so they only meet in the cache
+ *                       (pinning is Linux-only; elsewhere pinned=false)
+ *
+ * Per thread it reports wall time (from the common start to that thread's
+ * finish), CPU time and voluntary / involuntary context switches
+ * (getrusage(RUSAGE_THREAD), Linux; -1 elsewhere), plus a "process" row
+ * from getrusage(RUSAGE_SELF) over the whole run (-1 on Windows).
+ * wall_s - cpu_s is time the thread was runnable or asleep but off the CPU.
+ *
+ * Usage: ./step6-bench [--layout padded,false-shared,shared] [--pin none,same,different]
+ *                      [--yield-every 0,10000] [--iterations 50000000] [--format csv|json]
+ * Compile: g++ -std=c++20 -O2 -pthread step6-bench.cpp -o step6-bench
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <latch>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../common/affinity.hpp"
+#include "../../common/parallel_reduce.hpp"
+#include "../../common/perf_counters.hpp" // For perf::usage
+
+using Clock = std::chrono::steady_clock;
+using perf::Usage;
+
+// Two cache lines of sink slots; the layout decides which slot each thread writes
+struct alignas(parallel::CACHE_LINE) Sinks {
+    static constexpr std::size_t PER_LINE = parallel::CACHE_LINE / sizeof(std::uint64_t);
+    volatile std::uint64_t slot[2 * PER_LINE] = {};
+
+    volatile std::uint64_t& of(const std::string& layout, unsigned thread) {
+        if (layout == "shared") {
+            return slot[0];
+        }
+        return slot[layout == "false-shared" ? thread : thread * PER_LINE];
+    }
+};
+
+/**
+ * @brief step6's loop: add to 'sink', yielding every 'yield_every' iterations (0 = never).
+ */
+void spin(volatile std::uint64_t& sink, std::uint64_t iterations, std::uint64_t yield_every) {
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        sink = sink + (i & 1);
+        if (yield_every != 0 && i % yield_every == 0) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+struct Row {
+    std::string layout;
+    std::string pin;
+    std::uint64_t yield_every;
+    std::string thread;     // "spin", "yield" or "process"
+    bool pinned;
+    double wall_s;
+    Usage usage;
+};
+
+void run_config(const std::string& layout, const std::string& pin, std::uint64_t yield_every,
+                std::uint64_t iterations, std::vector<Row>& rows) {
+    Sinks sinks;
+    std::latch go(3);
+    Clock::time_point start;
+    Row thread_rows[2];
+    std::vector<std::thread> threads;
+
+    for (unsigned t = 0; t < 2; ++t) {
+        threads.emplace_back([&, t] {
+            bool pinned = false;
+            if (pin == "same") {
+                pinned = parallel::pin_current_thread(0);
+            } else if (pin == "different") {
+                pinned = parallel::pin_current_thread(t);
+            }
+            const Usage before = perf::usage(perf::Scope::Thread);
+            go.arrive_and_wait();
+            spin(sinks.of(layout, t), iterations, t == 0 ? 0 : yield_every);
+            const auto end = Clock::now();
+            thread_rows[t] = {layout, pin, yield_every, t == 0 ? "spin" : "yield", pinned,
+                              std::chrono::duration<double>(end - start).count(),
+                              perf::usage(perf::Scope::Thread) - before};
+        });
+    }
+
+    const Usage before = perf::usage(perf::Scope::Process);
+    start = Clock::now();
+    go.arrive_and_wait();
+    for (auto& th : threads) {
+        th.join();
+    }
+    const double wall_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+    rows.push_back(thread_rows[0]);
+    rows.push_back(thread_rows[1]);
+    rows.push_back({layout, pin, yield_every, "process", thread_rows[0].pinned && thread_rows[1].pinned,
+                    wall_s, perf::usage(perf::Scope::Process) - before});
+}
+
+std::vector<std::string> parse_list(const std::string& arg) {
+    std::vector<std::string> values;
+    std::stringstream ss(arg);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        values.push_back(item);
+    }
+    return values;
+}
+
+void print_csv(const std::vector<Row>& rows) {
+    std::cout << "layout,pin,yield_every,thread,pinned,wall_s,cpu_s,nvcsw,nivcsw\n";
+    for (const auto& r : rows) {
+        std::cout << r.layout << ',' << r.pin << ',' << r.yield_every << ',' << r.thread << ','
+                  << (r.pinned ? "true" : "false") << ',' << std::setprecision(6) << r.wall_s << ','
+                  << r.usage.cpu_s << ',' << r.usage.nvcsw << ',' << r.usage.nivcsw << '\n';
+    }
+}
+
+void print_json(const std::vector<Row>& rows) {
+    std::cout << "[\n";
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const auto& r = rows[i];
+        std::cout << "  {\"layout\": \"" << r.layout << "\""
+                  << ", \"pin\": \"" << r.pin << "\""
+                  << ", \"yield_every\": " << r.yield_every
+                  << ", \"thread\": \"" << r.thread << "\""
+                  << ", \"pinned\": " << (r.pinned ? "true" : "false")
+                  << std::setprecision(6) << ", \"wall_s\": " << r.wall_s
+                  << ", \"cpu_s\": " << r.usage.cpu_s
+                  << ", \"nvcsw\": " << r.usage.nvcsw
+                  << ", \"nivcsw\": " << r.usage.nivcsw << "}"
+                  << (i + 1 < rows.size() ? ",\n" : "\n");
+    }
+    std::cout << "]\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> layouts{"padded", "false-shared", "shared"};
+    std::vector<std::string> pins{"none"};
+    std::vector<std::string> yields{"0", "10000"};
+    std::uint64_t iterations = 50'000'000ULL;
+    std::string format = "csv";
+    bool valid = argc % 2 == 1;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        const std::string value = argv[i + 1];
+        if (flag == "--layout") {
+            layouts = parse_list(value);
+        } else if (flag == "--pin") {
+            pins = parse_list(value);
+        } else if (flag == "--yield-every") {
+            yields = parse_list(value);
+        } else if (flag == "--iterations") {
+            iterations = std::stoull(value);
+        } else if (flag == "--format") {
+            format = value;
+        } else {
+            std::cerr << "Unknown option " << flag << "\n";
+            valid = false;
+        }
+    }
+    for (const auto& l : layouts) {
+        valid = valid && (l == "padded" || l == "false-shared" || l == "shared");
+    }
+    for (const auto& p : pins) {
+        valid = valid && (p == "none" || p == "same" || p == "different");
+    }
+    if (!valid || (format != "csv" && format != "json")) {
+        std::cerr << "Usage: " << argv[0] << " [--layout padded,false-shared,shared]"
+                  << " [--pin none,same,different] [--yield-every 0,10000]"
+                  << " [--iterations 50000000] [--format csv|json]\n";
+        return 1;
+    }
+
+    std::vector<Row> rows;
+    for (const auto& layout : layouts) {
+        for (const auto& pin : pins) {
+            for (const auto& y : yields) {
+                run_config(layout, pin, std::stoull(y), iterations, rows);
+            }
+        }
+    }
+
+    if (format == "json") {
+        print_json(rows);
+    } else {
+        print_csv(rows);
+    }
+    return 0;
+}
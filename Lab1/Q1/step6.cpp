@@ -2,6 +2,10 @@
  #include <thread>
  #include <future>
  #include <chrono>
+ #include <cstdint>
+ #include <functional>
+
+ #include "../../common/parallel_reduce.hpp"
 
 /**
  * Step 6 - Using std::this_thread::yeild
@@ -10,17 +14,25 @@
  * Compare how this changes the behaviour or runtime when you observe CPU usage.
  */
 
- volatile std::uint64_t sink = 0;
- 
- void spin_no_yield() {
+ /**
+ * Follow-on: with one shared 'volatile sink' both loops fight over the same
+ * cache line, and that contention swamps the cost of yield() itself. Each
+ * thread now writes its own cache-line-padded sink. step6-bench compares
+ * shared / false-shared / padded sinks, pinning and yield intervals, with
+ * CPU time and context switches from getrusage.
+ */
+
+ parallel::Padded<volatile std::uint64_t> sinks[2] = {};
+
+ void spin_no_yield(volatile std::uint64_t& sink) {
     for (std::uint64_t i = 0; i < 50'000'000ULL; ++i) {
-        sink += i & 1;
+        sink = sink + (i & 1);
     }
  }
 
- void spin_with_yield() {
+ void spin_with_yield(volatile std::uint64_t& sink) {
     for (std::uint64_t i = 0; i < 50'000'000ULL; ++i) {
-        sink += i & 1;
+        sink = sink + (i & 1);
         
         if ((i % 10000ULL) == 0) {
             std::this_thread::yield();
@@ -29,8 +41,8 @@
  }
 
  int main () {
-    std::thread a(spin_no_yield);
-    std::thread b(spin_with_yield);
+    std::thread a(spin_no_yield, std::ref(sinks[0].value));
+    std::thread b(spin_with_yield, std::ref(sinks[1].value));
     a.join(); b.join();
-    std::cout << "done, sink = "<<sink<<"\n";
+    std::cout << "done, sink = "<<sinks[0].value + sinks[1].value<<"\n";
  }
\ No newline at end of file
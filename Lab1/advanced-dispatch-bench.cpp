@@ -0,0 +1,153 @@
+/**
+ * Cost of dispatching a task body: std::function vs inplace_function vs a
+ * static task set.
+ *
+ * Each variant hosts the same three small task bodies (a few arithmetic
+ * operations on captured state, like a sensor read into a buffer) and runs
+ * them once per simulated frame through the executive's real dispatch path,
+ * i.e. two Clock::now() calls and record_run() around every body:
+ *   std::function    - the executive's original Task::work, run the way
+ *                      dispatch() ran it
+ *   inplace_function - the current Task::work: cyclic::Task + cyclic::dispatch
+ *                      (fixed buffer, no allocation)
+ *   static set       - cyclic::StaticTaskSet built with make_static_task_set
+ *                      and run with run_frame(); the bodies sit in a tuple
+ *                      and are called directly, so the compiler can inline them
+ * The timing and bookkeeping are the same in all three rows, so differences
+ * come from how the body is stored and called.
+ * Global operator new is counted, so the table also shows how many heap
+ * allocations building the task bodies took (std::function allocates once its
+ * capture outgrows its small buffer; the other two never do).
+ *
+ * Usage: ./advanced-dispatch-bench [frames]
+ * Compile: g++ -std=c++20 -O2 -pthread advanced-dispatch-bench.cpp -o advanced-dispatch-bench
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include <array>
+
+#include "cyclic/executive.hpp"
+#include "cyclic/static_tasks.hpp"
+
+static std::uint64_t allocations = 0;
+
+void* operator new(std::size_t n) {
+    ++allocations;
+    if (void* p = std::malloc(n == 0 ? 1 : n)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Per-task state the bodies write into
+struct Sensor {
+    std::array<std::uint32_t, 8> samples{};
+    std::uint64_t reads = 0;
+};
+
+volatile std::uint64_t sink = 0;
+
+auto sensor_body(Sensor* s, std::uint32_t salt) {
+    // 40-byte closure: past std::function's small buffer, inside inplace_function's
+    return [s, salt, pad = std::array<std::uint32_t, 7>{}]() mutable {
+        s->samples[s->reads & 7] = static_cast<std::uint32_t>(s->reads * 2654435761u) ^ salt ^ pad[0];
+        s->reads++;
+    };
+}
+
+template <typename Call>
+double ns_per_frame(long long frames, Call&& call) {
+    const auto t0 = std::chrono::steady_clock::now();
+    for (long long f = 0; f < frames; ++f) {
+        call();
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(frames);
+}
+
+void print_row(const std::string& name, double ns, std::uint64_t allocs, const Sensor (&s)[3]) {
+    sink = sink + s[0].reads + s[1].reads + s[2].reads;
+    std::cout << std::left << std::setw(18) << name << std::right
+              << std::setw(10) << std::fixed << std::setprecision(2) << ns << " ns/frame"
+              << std::setw(8) << allocs << " allocations\n";
+}
+
+constexpr cyclic::ms PERIOD{10};
+constexpr cyclic::us BUDGET{100};
+
+/**
+ * @brief cyclic::dispatch() as it was when Task::work was a std::function.
+ */
+void dispatch_function(std::function<void()>& work, cyclic::RunStats& stats,
+                       cyclic::Clock::time_point release, cyclic::Clock::time_point now) {
+    const auto exec_start = cyclic::Clock::now();
+    work();
+    const auto exec_end = cyclic::Clock::now();
+    cyclic::record_run(stats, BUDGET, PERIOD,
+                       std::chrono::duration_cast<cyclic::us>(now - release).count(),
+                       std::chrono::duration_cast<cyclic::us>(exec_end - exec_start).count(),
+                       std::chrono::duration_cast<cyclic::us>(exec_end - release).count());
+}
+
+int main(int argc, char* argv[]) {
+    const long long frames = argc > 1 ? std::atoll(argv[1]) : 5'000'000;
+    // Every frame is released at t0 and picked up at t0, as in a frame loop
+    const auto t0 = cyclic::Clock::now();
+
+    std::cout << "Dispatching 3 task bodies per frame, " << frames << " frames\n";
+    {
+        Sensor s[3];
+        const std::uint64_t before = allocations;
+        std::function<void()> work[3] = {sensor_body(&s[0], 1), sensor_body(&s[1], 2), sensor_body(&s[2], 3)};
+        const std::uint64_t allocs = allocations - before;
+        static cyclic::RunStats stats[3];
+        const double ns = ns_per_frame(frames, [&] {
+            for (int i = 0; i < 3; ++i) {
+                dispatch_function(work[i], stats[i], t0, t0);
+            }
+        });
+        print_row("std::function", ns, allocs, s);
+    }
+    {
+        Sensor s[3];
+        std::vector<cyclic::Task> tasks;
+        tasks.reserve(3);
+        const std::uint64_t before = allocations;
+        for (int i = 0; i < 3; ++i) {
+            tasks.push_back({.name = "S", .period = PERIOD, .wcet_budget = BUDGET,
+                             .work = sensor_body(&s[i], static_cast<std::uint32_t>(i + 1))});
+        }
+        const std::uint64_t allocs = allocations - before;
+        const double ns = ns_per_frame(frames, [&] {
+            for (auto& t : tasks) {
+                cyclic::dispatch(t, t0, t0);
+            }
+        });
+        print_row("inplace_function", ns, allocs, s);
+    }
+    {
+        Sensor s[3];
+        const std::uint64_t before = allocations;
+        auto set = cyclic::make_static_task_set<10, 10>(
+            cyclic::make_static_task<10, 0, 100>("S0", sensor_body(&s[0], 1)),
+            cyclic::make_static_task<10, 0, 100>("S1", sensor_body(&s[1], 2)),
+            cyclic::make_static_task<10, 0, 100>("S2", sensor_body(&s[2], 3)));
+        const std::uint64_t allocs = allocations - before;
+        const double ns = ns_per_frame(frames, [&] {
+            set.run_frame(0, t0, t0);
+        });
+        print_row("static set", ns, allocs, s);
+    }
+    return 0;
+}
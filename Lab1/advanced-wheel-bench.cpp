@@ -0,0 +1,127 @@
+/**
+ * Per-tick dispatch cost of the release engine, from 10 to 100k tasks.
+ *
+ * Runs the release bookkeeping of the executive in simulated ticks (no
+ * sleeping, empty task bodies) and compares:
+ *   scan  - the original loop: every tick, compare every task's next release
+ *           and catch up slipped periods with a while loop
+ *   wheel - cyclic::TimingWheel with periodic entries: expire the current
+ *           slot, the wheel re-arms each released task one period later
+ * Periods are drawn so that the average number of releases per tick stays
+ * the same for every task count, so any growth in ns/tick is overhead that
+ * scales with the number of hosted tasks rather than with the work released.
+ *
+ * The scan grows linearly with the task count (about 10^4x from 10 to 100k
+ * tasks). The wheel is not flat: its cost per release still grows about 4-5x
+ * (roughly 6-10 ns at 10 tasks to 28-33 ns at 100k on a 2 MiB-L2 Xeon VM).
+ * Because periods grow with the task count here, entries start in higher
+ * wheel levels and are moved down once per level (none at 10 tasks, two at
+ * 100k), and the 1.6 MB of slot arrays at 100k no longer fits in L2.
+ *
+ * Usage: ./advanced-wheel-bench [ticks] [releases_per_tick]
+ * Compile: g++ -std=c++20 -O2 -pthread advanced-wheel-bench.cpp -o advanced-wheel-bench
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <string>
+
+#include "cyclic/timing_wheel.hpp"
+
+using Tick = cyclic::TimingWheel::Tick;
+
+struct Job {
+    Tick period;
+    Tick next_release;
+};
+
+// Keeps the compiler from discarding the dispatch loops
+volatile std::uint64_t sink = 0;
+
+/**
+ * @brief 'n' jobs whose periods average n / rate ticks, with random phases.
+ */
+std::vector<Job> make_jobs(std::size_t n, double rate, std::uint32_t seed) {
+    std::mt19937 gen(seed);
+    const double mean = std::max(1.0, static_cast<double>(n) / rate);
+    std::uniform_int_distribution<Tick> period(static_cast<Tick>(mean / 2) + 1, static_cast<Tick>(mean * 3 / 2) + 1);
+    std::vector<Job> jobs(n);
+    for (auto& j : jobs) {
+        j.period = period(gen);
+        j.next_release = std::uniform_int_distribution<Tick>(0, j.period - 1)(gen);
+    }
+    return jobs;
+}
+
+struct Result {
+    double ns_per_tick;
+    double releases_per_tick;
+};
+
+Result bench_scan(std::vector<Job> jobs, Tick ticks) {
+    std::uint64_t released = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (Tick now = 0; now < ticks; ++now) {
+        for (auto& j : jobs) {
+            if (now >= j.next_release) {
+                released++;
+                j.next_release += j.period;
+                while (j.next_release < now) {
+                    j.next_release += j.period;
+                }
+            }
+        }
+    }
+    const auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    sink = sink + released;
+    return {ns / static_cast<double>(ticks), static_cast<double>(released) / static_cast<double>(ticks)};
+}
+
+Result bench_wheel(const std::vector<Job>& jobs, Tick ticks) {
+    cyclic::TimingWheel wheel;
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        wheel.schedule(static_cast<cyclic::TimingWheel::Id>(i), jobs[i].next_release,
+                       static_cast<std::uint32_t>(jobs[i].period));
+    }
+
+    // Periodic entries re-arm inside the wheel, as in run_wheel_executive()
+    std::uint64_t released = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (Tick now = 0; now < ticks; ++now) {
+        wheel.advance(now, [&](cyclic::TimingWheel::Id, Tick) {
+            released++;
+        });
+    }
+    const auto ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    sink = sink + released;
+    return {ns / static_cast<double>(ticks), static_cast<double>(released) / static_cast<double>(ticks)};
+}
+
+int main(int argc, char* argv[]) {
+    const Tick ticks = argc > 1 ? std::stoull(argv[1]) : 20000;
+    const double rate = argc > 2 ? std::stod(argv[2]) : 10.0;
+
+    std::cout << "ticks=" << ticks << " target releases/tick=" << rate << "\n";
+    std::cout << std::setw(8) << "tasks"
+              << std::setw(14) << "releases/tick"
+              << std::setw(16) << "scan ns/tick"
+              << std::setw(16) << "wheel ns/tick"
+              << std::setw(18) << "wheel ns/release" << "\n";
+
+    for (std::size_t n : {10u, 100u, 1000u, 10000u, 100000u}) {
+        const std::vector<Job> jobs = make_jobs(n, rate, 12345);
+        const Result scan = bench_scan(jobs, ticks);
+        const Result wheel = bench_wheel(jobs, ticks);
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << std::setw(8) << n
+                  << std::setw(14) << wheel.releases_per_tick
+                  << std::setw(16) << scan.ns_per_tick
+                  << std::setw(16) << wheel.ns_per_tick
+                  << std::setw(18) << wheel.ns_per_tick / std::max(wheel.releases_per_tick, 1e-9) << "\n";
+    }
+}
@@ -12,176 +12,584 @@
  * can guarantee that all tasks finish within their assigned time slots.
  * 4. Sleep-until frame boundary: Avoids busy waiting; shows frame-overrun
  * warnings if you overload the frame.
+ *
+ * The executive itself lives in cyclic/executive.hpp.
+ *
+ * Usage: ./advanced [--mode single|partitioned|edf|rm|static] [--dispatch scan|table|wheel]
+ *                   [--cores N] [--copies K] [--heavy 0|1] [--fifo 0|1]
+ *                   [--majors N] [--snapshot N] [--export stats.csv] [--wait sleep|hybrid]
+ *                   [--clock steady|tsc] [--profile N] [--admit 0|1]
+ *                   [--aperiodic RATE] [--server polling|deferrable]
+ *                   [--server-period N] [--server-capacity US]
+ *   --mode single      - original behaviour: every task on one executive (default)
+ *   --mode partitioned - tasks bin-packed onto cores by utilisation, one pinned
+ *                        executive per core, all frames aligned to a common epoch
+ *   --mode edf|rm      - no frames: a release thread and a worker pool with
+ *                        earliest-deadline-first or rate-monotonic preemption
+ *                        on --cores CPUs (default 1); SCHED_FIFO when permitted
+ *                        (--fifo 0 forces the cooperative fallback)
+ *   --mode static      - the demo task set as a compile-time tuple: frame table
+ *                        and budget checks at compile time, bodies dispatched
+ *                        without std::function (ignores --dispatch/--copies/--profile)
+ *   --dispatch scan    - check every task's next release each frame (default)
+ *   --dispatch table   - precompute the hyperperiod frame -> task table and index
+ *                        it by frame; task sets whose frames overflow are rejected
+ *   --dispatch wheel   - release from a hierarchical timing wheel (1 ms ticks),
+ *                        for large task sets
+ *   --copies K replicates the demo task set to create more load than one core
+ *   can carry (e.g. "--mode partitioned --cores 4 --copies 4" places 4 x 45%).
+ *   --heavy 1 adds a 35 ms Housekeeping job every 100 ms (U=0.85 in total):
+ *   no frame can hold it, but EDF/RM still meet every deadline.
+ *   --majors N runs N major cycles (default 5); --snapshot N prints jitter /
+ *   execution / slack percentiles every N major cycles; --export writes the
+ *   final percentiles as CSV (one row per scope, task and metric).
+ *   --wait hybrid sleeps to an adaptive margin before each frame boundary and
+ *   spins the rest, cutting release jitter at the cost of the reported spin CPU.
+ *   --clock tsc takes every executive and busy_work_us timestamp from the
+ *   calibrated invariant TSC (falls back to steady_clock if there is none).
+ *   --profile N times every task body N times (every 10th run cache-cold)
+ *   before starting and replaces the hand-set WCET budgets with the
+ *   statistical estimates (cyclic/wcet.hpp).
+ *   Before running, the task set must pass admission control for its mode
+ *   (cyclic/admission.hpp): frame budgets for the executive, utilisation or
+ *   response-time analysis for EDF/RM; partitioning only places a task on a
+ *   core whose frames still fit. --admit 0 reports a failure but runs anyway
+ *   (e.g. to watch --heavy 1 slip frames).
+ *   --aperiodic RATE starts two producer threads submitting about RATE jobs/s
+ *   in total (0.2 - 1.5 ms of work each) to an aperiodic server that runs them
+ *   in the frames' slack (cyclic/aperiodic.hpp); single, partitioned and
+ *   static modes only. --server picks polling (default) or deferrable.
+ *   The server gets --server-capacity US of execution time (default 10000)
+ *   every --server-period N minor frames (default 5). With a period of one
+ *   frame the capacity is refilled before every serve, so polling and
+ *   deferrable behave the same.
+ *   Every report ends with the run's wall and CPU time, context switches and,
+ *   where perf events are available, cycles / instructions / LLC and branch
+ *   misses (common/perf_counters.hpp); partitioned mode adds one line per core.
  */
 
 #include <chrono>
 #include <thread>
 #include <string>
 #include <vector>
-#include <functional>
 #include <iomanip>
 #include <iostream>
-#include <cmath> // For std::llabs
-
-// Type aliases for clarity
-using Clock = std::chrono::steady_clock;
-using ms = std::chrono::milliseconds;
-using us = std::chrono::microseconds;
-
-// --- Utilities to simulate work and measure timing ---
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <random>
+#include <atomic>
 
-/**
- * @brief Simulate work by spinning for a target number of microseconds.
- * @param target_us The approximate number of microseconds to spin.
- */
-void busy_work_us(int target_us) {
-    auto start = Clock::now();
-    while (std::chrono::duration_cast<us>(Clock::now() - start).count() < target_us) {
-        // This loop intentionally consumes CPU to simulate execution time.
-        // In a real x86 system, you might use _mm_pause() here
-        // to be friendlier to hyper-threading.
-    }
-}
+#include "cyclic/admission.hpp"
+#include "cyclic/executive.hpp"
+#include "cyclic/partition.hpp"
+#include "cyclic/preemptive.hpp"
+#include "cyclic/schedule_table.hpp"
+#include "cyclic/static_tasks.hpp"
+#include "../common/perf_counters.hpp"
+#include "cyclic/timing_wheel.hpp"
+#include "cyclic/wcet.hpp"
 
-/**
- * @brief Holds execution statistics for a single task.
- */
-struct RunStats {
-    int runs = 0;
-    long long worst_jitter_us = 0;
-    long long worst_exec_us = 0;
-    int overruns = 0;
-};
+using namespace cyclic;
 
 /**
- * @brief Defines a single periodic task for the executive.
+ * @brief The demo task set, replicated 'copies' times (copy k gets suffix "#k").
+ *        Task bodies time their simulated work with clock policy C.
  */
-struct Task {
-    std::string name;
-    ms period;              // How often to execute
-    ms phase{0};            // Initial delay before first release
-    us wcet_budget;         // Execution budget (microseconds)
-    std::function<void()> work; // The task body
-    Clock::time_point next_release; // When the task is next due
-    RunStats stats{};
-};
-
-// ------------------------------------------------------------------
-// Schedule table for a 10 ms minor cycle (time-triggered)
-// ------------------------------------------------------------------
-int main() {
+template <typename C>
+std::vector<Task> make_tasks(int copies, bool heavy) {
     // Enable C++ chrono literals (e.g., 10ms, 2000us)
     using namespace std::chrono_literals;
 
-    const ms minor_cycle{10};     // 10 ms frame
-    const ms major_cycle{100};    // 100 ms (10 frames)
-    const int major_cycles_to_run = 5; // demo runtime ≈ 0.5 s
-    const ms slip_tolerance{1}; // Allowable slip before warning
+    std::vector<Task> tasks;
+    for (int k = 0; k < copies; ++k) {
+        const std::string suffix = copies > 1 ? "#" + std::to_string(k) : "";
 
-    // Define tasks directly in the vector using C++20 aggregate initialization
-    std::vector<Task> tasks{
-        {
-            .name = "SensorRead",
+        // Define tasks directly using C++20 aggregate initialization
+        tasks.push_back({
+            .name = "SensorRead" + suffix,
             .period = 10ms,
             .phase = 0ms,
             .wcet_budget = 2000us, // 2 ms
-            .work = [] { busy_work_us(1500); }
-        },
-        {
-            .name = "Control",
+            .work = [] { busy_work_us<C>(1500); }
+        });
+        tasks.push_back({
+            .name = "Control" + suffix,
             .period = 20ms,
             .phase = 0ms,
             .wcet_budget = 3000us, // 3 ms
-            .work = [] { busy_work_us(2200); }
-        },
-        {
-            .name = "CommTx",
+            .work = [] { busy_work_us<C>(2200); }
+        });
+        tasks.push_back({
+            .name = "CommTx" + suffix,
             .period = 50ms,
             .phase = 0ms,
             .wcet_budget = 5000us, // 5 ms
-            .work = [] { busy_work_us(3500); }
+            .work = [] { busy_work_us<C>(3500); }
+        });
+    }
+    if (heavy) {
+        tasks.push_back({
+            .name = "Housekeep",
+            .period = 100ms,
+            .phase = 0ms,
+            .wcet_budget = 40000us, // 40 ms, longer than a frame
+            .work = [] { busy_work_us<C>(35000); }
+        });
+    }
+    return tasks;
+}
+
+void print_frame_report(const FrameStats& fs, const ExecConfig& cfg) {
+    std::cout << "Frames " << fs.frames
+              << " slack min=" << fs.min_slack_us << " us"
+              << " mean=" << std::fixed << std::setprecision(0) << fs.mean_slack_us() << " us"
+              << " slips=" << fs.slips << "\n";
+    if (cfg.wait == WaitMode::Hybrid && fs.frames > 0) {
+        // CPU burnt spinning, as a share of the run
+        const double run_us = static_cast<double>(fs.frames)
+                            * static_cast<double>(std::chrono::duration_cast<us>(cfg.minor_cycle).count());
+        std::cout << "Hybrid wait: spin=" << fs.wait.spin_us / 1000 << " ms ("
+                  << std::setprecision(1) << 100.0 * static_cast<double>(fs.wait.spin_us) / run_us
+                  << "% CPU) margin=" << fs.wait.margin_us << " us late_wakeups=" << fs.wait.late_wakeups << "\n";
+    }
+}
+
+void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [--mode single|partitioned|edf|rm|static] [--dispatch scan|table|wheel]"
+              << " [--cores N] [--copies K] [--heavy 0|1] [--fifo 0|1]"
+              << " [--majors N] [--snapshot N] [--export stats.csv] [--wait sleep|hybrid]"
+              << " [--clock steady|tsc] [--profile N] [--admit 0|1]"
+              << " [--aperiodic RATE] [--server polling|deferrable]"
+              << " [--server-period N] [--server-capacity US]\n";
+}
+
+void print_table(const ScheduleTable& table, const std::vector<Task*>& tasks) {
+    std::cout << "Schedule table: hyperperiod=" << table.hyperperiod.count() << " ms\n";
+    for (std::size_t f = 0; f < table.frames.size(); ++f) {
+        std::cout << "  frame " << std::setw(2) << f << " load=" << std::setw(5)
+                  << table.frame_load_us[f] << " us:";
+        for (const std::size_t i : table.frames[f]) {
+            std::cout << ' ' << tasks[i]->name;
         }
-    };
+        std::cout << "\n";
+    }
+}
 
-    // Initialise next releases relative to executive start
-    const auto t0 = Clock::now();
-    for (auto& t : tasks) {
-        t.next_release = t0 + t.phase;
+void print_wcet_profile(const Task& t, const WcetProfile& p) {
+    std::cout << "WCET " << std::left << std::setw(12) << t.name << std::right
+              << " warm p99=" << std::setw(6) << p.warm.percentile(99) << " max=" << std::setw(6) << p.warm.max()
+              << " cold p99=" << std::setw(6) << p.cold.percentile(99) << " max=" << std::setw(6) << p.cold.max()
+              << " gumbel=" << std::setw(6) << p.gumbel_us
+              << " -> budget " << std::setw(6) << p.estimate.count()
+              << " us (was " << t.wcet_budget.count() << ")\n";
+}
+
+/**
+ * @brief Print the admission decision.
+ * @return true if the task set may run (admitted, or 'enforce' is off).
+ */
+bool report_admission(const Admission& a, const std::vector<Task*>& tasks, bool enforce) {
+    if (!a.ok()) {
+        std::cerr << "Task set rejected (" << a.test << "): " << a.error << "\n";
+        if (enforce) {
+            return false;
+        }
+        std::cerr << "[WARN] --admit 0: running anyway\n";
+        return true;
     }
+    std::cout << "Admitted (" << a.test << ")";
+    for (std::size_t i = 0; i < a.response_us.size(); ++i) {
+        std::cout << (i == 0 ? ":" : ",") << " " << tasks[i]->name << " R=" << a.response_us[i] << " us";
+    }
+    std::cout << "\n";
+    return true;
+}
 
-    std::cout << "Cyclic Executive: minor=" << minor_cycle.count()
-              << " ms, major=" << major_cycle.count() << " ms\n";
+/**
+ * @brief Event-driven load for the aperiodic server: 'producers' threads
+ *        submitting jobs with exponential inter-arrival times until stopped.
+ */
+template <typename C>
+class AperiodicLoad {
+    public:
+        AperiodicLoad(AperiodicServer& server, double rate, unsigned producers = 2) {
+            for (unsigned k = 0; k < producers; ++k) {
+                threads_.emplace_back([this, &server, rate, producers, k] {
+                    std::mt19937 rng(k + 1);
+                    std::exponential_distribution<double> gap(rate / producers);
+                    std::uniform_int_distribution<int> work(200, 1500);
+                    while (!stop_.load(std::memory_order_relaxed)) {
+                        std::this_thread::sleep_for(std::chrono::duration<double>(gap(rng)));
+                        const int cost = work(rng);
+                        // Declared cost with 25% headroom over the simulated work
+                        server.submit([cost] { busy_work_us<C>(cost); }, us{cost + cost / 4});
+                    }
+                });
+            }
+        }
 
-    auto frame_start = t0;
-    const auto end_time = t0 + major_cycle * major_cycles_to_run;
-    int frame_idx = 0;
+        ~AperiodicLoad() { stop(); }
 
-    // --- Main Executive Loop ---
-    while (Clock::now() < end_time) {
-        // 1) Release and execute due tasks within this frame
-        auto now = Clock::now();
-        for (auto& t : tasks) {
-            if (now >= t.next_release) {
-                // Measure release jitter vs exact schedule point
-                const auto jitter_us =
-                    std::chrono::duration_cast<us>(now - t.next_release).count();
-                if (std::llabs(jitter_us) > t.stats.worst_jitter_us) {
-                    t.stats.worst_jitter_us = std::llabs(jitter_us);
+        void stop() {
+            stop_.store(true, std::memory_order_relaxed);
+            for (auto& th : threads_) {
+                if (th.joinable()) {
+                    th.join();
                 }
+            }
+        }
 
-                // Execute task and measure execution time
-                const auto exec_start = Clock::now();
-                t.work();
-                const auto exec_us =
-                    std::chrono::duration_cast<us>(Clock::now() - exec_start).count();
+    private:
+        std::atomic<bool> stop_{false};
+        std::vector<std::thread> threads_;
+};
 
-                // Update execution stats
-                if (exec_us > t.stats.worst_exec_us) {
-                    t.stats.worst_exec_us = exec_us;
-                }
-                if (exec_us > t.wcet_budget.count()) {
-                    t.stats.overruns++;
-                }
-                t.stats.runs++;
+void print_aperiodic_report(const AperiodicServer& server, const ExecConfig& cfg) {
+    const AperiodicStats& st = server.stats();
+    const double seconds = std::chrono::duration<double>(cfg.major_cycle * cfg.major_cycles_to_run).count();
+    std::cout << "Aperiodic (" << (server.config().kind == ServerKind::Polling ? "polling" : "deferrable")
+              << " server, " << server.config().capacity.count() << " us per "
+              << server.config().period_frames << " frame(s)): submitted=" << st.submitted.load()
+              << " completed=" << st.completed << " rejected=" << st.rejected.load()
+              << " backlog=" << server.backlog() << " overruns=" << st.overruns
+              << " throughput=" << std::setprecision(1) << static_cast<double>(st.completed) / seconds << " jobs/s"
+              << " busy=" << st.busy_us / 1000 << " ms\n";
+    print_percentile_row("aperiodic response", st.response_hist);
+    print_percentile_row("aperiodic exec", st.exec_hist);
+}
+
+/**
+ * @brief Average cost of one C::now() call, in ns.
+ */
+template <typename C>
+double now_cost_ns() {
+    constexpr int CALLS = 1'000'000;
+    long long sink = 0;
+    const auto start = Clock::now();
+    for (int i = 0; i < CALLS; ++i) {
+        sink += C::now().time_since_epoch().count();
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    return sink == 0 ? 0.0 : elapsed / CALLS; // 'sink' keeps the loop alive
+}
 
-                // Schedule next release (strict periodic)
-                t.next_release += t.period;
+struct Options {
+    std::string mode = "single";
+    unsigned num_cores = 0; // default: all hardware threads (partitioned), 1 (edf/rm)
+    int copies = 1;
+    bool heavy = false;
+    bool fifo = true;
+    std::string export_path;
+    int profile = 0;        // WCET profiling runs per task, 0 = keep the hand-set budgets
+    bool admit = true;      // refuse task sets that fail admission control
+    double aperiodic = 0.0; // aperiodic jobs per second, 0 = no server
+    ServerConfig server;    // aperiodic server policy, capacity and period
+};
 
-                // Catch up if we slipped multiple periods
-                while (t.next_release < now) {
-                    t.next_release += t.period;
-                }
+/**
+ * @brief Run the selected mode with every executive timestamp taken from C.
+ */
+template <typename C>
+int run_demo(const Options& opt, ExecConfig cfg) {
+    const std::string& mode = opt.mode;
+    const unsigned num_cores = opt.num_cores;
+    const bool preemptive = mode == "edf" || mode == "rm";
+
+    std::vector<Task> tasks = make_tasks<C>(opt.copies, opt.heavy);
+    std::vector<Task*> all;
+    for (auto& t : tasks) {
+        all.push_back(&t);
+    }
+
+    if (opt.profile > 0 && mode != "static") {
+        WcetConfig wcfg;
+        wcfg.runs = opt.profile;
+        wcfg.block = std::max(1, std::min(wcfg.block, opt.profile / 10));
+        for (auto& t : tasks) {
+            const WcetProfile p = profile_wcet<C>(t, wcfg);
+            print_wcet_profile(t, p);
+            t.wcet_budget = p.estimate;
+        }
+    }
+
+    // Periodic snapshot, built as one string so cores do not interleave
+    cfg.on_snapshot = [&cfg](const std::vector<Task*>& ts, const FrameStats& fs, const std::string& label) {
+        std::ostringstream snap;
+        snap << "[snapshot" << (label.empty() ? "" : " " + label) << " @ " << fs.frames << " frames]\n";
+        print_percentile_report(ts, fs.frames > 0 ? &fs : nullptr, cfg, snap);
+        std::cout << snap.str();
+    };
+
+    // CSV export of the final percentiles; 'scope' is "all" or "core N"
+    std::ofstream export_file;
+    if (!opt.export_path.empty()) {
+        export_file.open(opt.export_path);
+        if (!export_file) {
+            std::cerr << "Cannot write " << opt.export_path << "\n";
+            return 1;
+        }
+        write_stats_csv_header(export_file);
+    }
+
+    double total_util = 0.0;
+    for (const auto& t : tasks) {
+        total_util += t.utilisation();
+    }
+
+    std::cout << "Cyclic Executive: minor=" << cfg.minor_cycle.count()
+              << " ms, major=" << cfg.major_cycle.count() << " ms, "
+              << tasks.size() << " tasks, U=" << std::fixed << std::setprecision(2) << total_util << "\n";
+
+    // Aperiodic server in the frame slack, fed by producer threads while the executive runs
+    ServerConfig server_cfg = opt.server;
+    server_cfg.frame = cfg.minor_cycle; // jobs longer than a frame would block the queue
+    AperiodicServer server(server_cfg);
+    std::unique_ptr<AperiodicLoad<C>> load;
+    if (opt.aperiodic > 0.0 && !preemptive) {
+        cfg.server = &server;
+        load = std::make_unique<AperiodicLoad<C>>(server, opt.aperiodic);
+    }
+    const auto report_aperiodic = [&] {
+        if (load) {
+            load->stop();
+            print_aperiodic_report(server, cfg);
+        }
+    };
+
+    if (mode == "single") {
+        if (!report_admission(admit_frames(all, cfg), all, opt.admit)) {
+            return 1;
+        }
+
+        ScheduleTable table;
+        if (cfg.dispatch == Dispatch::Table) {
+            // Built offline, before the executive starts; overloaded frames are rejected here
+            table = build_schedule(all, cfg);
+            if (!table.ok()) {
+                std::cerr << "Task set rejected: " << table.error << "\n";
+                return 1;
             }
+            print_table(table, all);
         }
 
-        // 2) Sleep until the next frame boundary (non-busy)
-        frame_idx = (frame_idx + 1) % (major_cycle / minor_cycle);
-        frame_start += minor_cycle;
-        std::this_thread::sleep_until(frame_start);
+        FrameStats fs;
+        perf::ScopedProfiler prof("executive");
+        if (cfg.dispatch == Dispatch::Table) {
+            fs = run_table_executive<C>(all, table, cfg, Clock::now());
+        } else if (cfg.dispatch == Dispatch::Wheel) {
+            fs = run_wheel_executive<C>(all, cfg, Clock::now());
+        } else {
+            fs = run_executive<C>(all, cfg, Clock::now());
+        }
+        const perf::Sample counters = prof.stop();
 
-        // Optional: detect frame overrun (if tasks exceeded frame budget)
-        auto after_sleep = Clock::now();
-        if (after_sleep > frame_start + slip_tolerance) {
-            auto slip = std::chrono::duration_cast<us>(after_sleep - frame_start).count();
-            // Use std::cerr for warnings
-            std::cerr << "[WARN] Frame overrun: slipped by " << slip << " us\n";
+        // ------------------------------------------------------------------
+        // Report
+        // ------------------------------------------------------------------
+        std::cout << "\n=== Report ("
+                  << cfg.major_cycles_to_run << " majors of "
+                  << cfg.major_cycle.count() << " ms) ===\n";
+        print_task_report(all);
+        print_frame_report(fs, cfg);
+        print_percentile_report(all, &fs, cfg);
+        std::cout << perf::format(prof.label(), counters) << "\n";
+        report_aperiodic();
+        if (export_file.is_open()) {
+            write_stats_csv(export_file, "all", all, &fs);
         }
+        std::cout << "Done.\n";
+        return 0;
     }
 
-    // ------------------------------------------------------------------
-    // Report
-    // ------------------------------------------------------------------
-    std::cout << "\n=== Report ("
-              << major_cycles_to_run << " majors of "
-              << major_cycle.count() << " ms) ===\n";
+    if (mode == "static") {
+        // Same tasks as make_tasks(), with their timing in the type
+        auto set = make_static_task_set<10, 100>(
+            make_static_task<10, 0, 2000>("SensorRead", [] { busy_work_us<C>(1500); }),
+            make_static_task<20, 0, 3000>("Control", [] { busy_work_us<C>(2200); }),
+            make_static_task<50, 0, 5000>("CommTx", [] { busy_work_us<C>(3500); }));
+
+        perf::ScopedProfiler prof("static executive");
+        const FrameStats fs = run_static_executive<C>(set, cfg, Clock::now());
+        const perf::Sample counters = prof.stop();
 
-    for (const auto& t : tasks) { // Use const& for read-only access
-        std::cout << "Task " << std::left << std::setw(10) << t.name
-                  << " runs=" << std::setw(4) << t.stats.runs
-                  << " worst_jitter=" << std::setw(6) << t.stats.worst_jitter_us << " us"
-                  << " worst_exec=" << std::setw(6) << t.stats.worst_exec_us << " us"
-                  << " overruns=" << t.stats.overruns
-                  << "\n";
+        std::cout << "\n=== Static report ("
+                  << cfg.major_cycles_to_run << " majors of "
+                  << cfg.major_cycle.count() << " ms) ===\n";
+        set.for_each([](const auto& t) { print_task_line(t.name, t.stats); });
+        print_frame_report(fs, cfg);
+        set.for_each([](const auto& t) {
+            print_percentile_row(std::string(t.name) + " jitter", t.stats.jitter_hist);
+            print_percentile_row(std::string(t.name) + " exec", t.stats.exec_hist);
+        });
+        print_percentile_report({}, &fs, cfg);
+        std::cout << perf::format(prof.label(), counters) << "\n";
+        report_aperiodic();
+        if (export_file.is_open()) {
+            set.for_each([&export_file](const auto& t) {
+                write_stats_csv_row(export_file, "static", t.name, "jitter", t.stats.jitter_hist);
+                write_stats_csv_row(export_file, "static", t.name, "exec", t.stats.exec_hist);
+            });
+            write_stats_csv_row(export_file, "static", "", "frame_busy", fs.busy_hist);
+        }
+        std::cout << "Done.\n";
+        return 0;
     }
+
+    if (preemptive) {
+        const Admission a = mode == "edf" ? admit_edf(all, num_cores) : admit_rm(all, num_cores);
+        if (!report_admission(a, all, opt.admit)) {
+            return 1;
+        }
+
+        DispatcherConfig dcfg;
+        dcfg.policy = mode == "edf" ? Policy::EDF : Policy::RM;
+        dcfg.cpus = num_cores;
+        dcfg.realtime = opt.fifo;
+        PreemptiveDispatcher dispatcher(all, cfg, dcfg);
+        perf::ScopedProfiler prof("dispatcher");
+        const DispatcherReport dr = dispatcher.run(Clock::now());
+        const perf::Sample counters = prof.stop();
+
+        std::cout << "\n=== " << (mode == "edf" ? "EDF" : "RM") << " report ("
+                  << cfg.major_cycles_to_run << " majors of "
+                  << cfg.major_cycle.count() << " ms, " << num_cores << " cpu(s), "
+                  << (dr.realtime ? "SCHED_FIFO" : "normal priority, cooperative") << ") ===\n";
+        print_task_report(all);
+        print_percentile_report(all, nullptr, cfg);
+        if (export_file.is_open()) {
+            write_stats_csv(export_file, "all", all, nullptr);
+        }
+        std::cout << "Jobs " << dr.jobs << " preemptions=" << dr.preemptions
+                  << " skipped=" << dr.skipped << "\n";
+        std::cout << perf::format(prof.label(), counters) << "\n";
+        std::cout << "Done.\n";
+        return 0;
+    }
+
+    // --- Partitioned: bin-pack by utilisation (and frame budgets), one pinned executive per core ---
+    std::vector<Partition> parts = partition_tasks(tasks, num_cores, 1.0, opt.admit ? &cfg : nullptr);
+    if (parts.empty()) {
+        std::cerr << "Task set (U=" << total_util << ") does not fit on "
+                  << num_cores << " cores\n";
+        return 1;
+    }
+    std::cout << "Admitted (" << (opt.admit ? "frame budgets" : "utilisation only")
+              << ") on " << parts.size() << " core(s)\n";
+    if (cfg.dispatch == Dispatch::Table) {
+        if (const std::string error = build_tables(parts, cfg); !error.empty()) {
+            std::cerr << "Task set rejected: " << error << "\n";
+            return 1;
+        }
+    }
+
+    // Common epoch a little in the future so every core is pinned and waiting
+    const auto t0 = Clock::now() + ms{50};
+    perf::ScopedProfiler prof("all cores");
+    const std::vector<CoreResult> results = run_partitioned<C>(parts, cfg, t0);
+    const perf::Sample counters = prof.stop();
+
+    std::cout << "\n=== Partitioned report ("
+              << parts.size() << " of " << num_cores << " cores, "
+              << cfg.major_cycles_to_run << " majors of "
+              << cfg.major_cycle.count() << " ms) ===\n";
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+        std::cout << "\n--- Core " << i << " (cpu " << results[i].cpu
+                  << (results[i].pinned ? ", pinned" : ", unpinned")
+                  << ") U=" << std::setprecision(2) << parts[i].utilisation << " ---\n";
+        print_task_report(parts[i].tasks);
+        print_frame_report(results[i].frames, cfg);
+        print_percentile_report(parts[i].tasks, &results[i].frames, cfg);
+        std::cout << perf::format("core " + std::to_string(i), results[i].counters) << "\n";
+        if (export_file.is_open()) {
+            write_stats_csv(export_file, "core " + std::to_string(i), parts[i].tasks, &results[i].frames);
+        }
+    }
+    std::cout << "\n" << perf::format(prof.label(), counters) << "\n";
+    report_aperiodic();
     std::cout << "Done.\n";
-}
\ No newline at end of file
+    return 0;
+}
+
+// ------------------------------------------------------------------
+// Schedule table for a 10 ms minor cycle (time-triggered)
+// ------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    ExecConfig cfg; // 10 ms minor, 100 ms major, 5 majors, 1 ms slip tolerance
+    Options opt;
+    bool tsc = false;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        const std::string value = argv[i + 1];
+        if (flag == "--mode") {
+            opt.mode = value;
+        } else if (flag == "--dispatch") {
+            if (value == "scan") {
+                cfg.dispatch = Dispatch::Scan;
+            } else if (value == "table") {
+                cfg.dispatch = Dispatch::Table;
+            } else if (value == "wheel") {
+                cfg.dispatch = Dispatch::Wheel;
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (flag == "--cores") {
+            opt.num_cores = static_cast<unsigned>(std::stoi(value));
+        } else if (flag == "--copies") {
+            opt.copies = std::stoi(value);
+        } else if (flag == "--heavy") {
+            opt.heavy = value == "1";
+        } else if (flag == "--fifo") {
+            opt.fifo = value != "0";
+        } else if (flag == "--majors") {
+            cfg.major_cycles_to_run = std::stoi(value);
+        } else if (flag == "--snapshot") {
+            cfg.snapshot_every = std::stoi(value);
+        } else if (flag == "--export") {
+            opt.export_path = value;
+        } else if (flag == "--wait" && (value == "sleep" || value == "hybrid")) {
+            cfg.wait = value == "hybrid" ? WaitMode::Hybrid : WaitMode::Sleep;
+        } else if (flag == "--clock" && (value == "steady" || value == "tsc")) {
+            tsc = value == "tsc";
+        } else if (flag == "--profile") {
+            opt.profile = std::stoi(value);
+        } else if (flag == "--admit") {
+            opt.admit = value != "0";
+        } else if (flag == "--aperiodic") {
+            opt.aperiodic = std::stod(value);
+        } else if (flag == "--server" && (value == "polling" || value == "deferrable")) {
+            opt.server.kind = value == "polling" ? ServerKind::Polling : ServerKind::Deferrable;
+        } else if (flag == "--server-period") {
+            opt.server.period_frames = std::stoi(value);
+        } else if (flag == "--server-capacity") {
+            opt.server.capacity = us{std::stoll(value)};
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    const bool preemptive = opt.mode == "edf" || opt.mode == "rm";
+    const bool known = opt.mode == "single" || opt.mode == "partitioned" || opt.mode == "static" || preemptive;
+    if (argc % 2 == 0 || !known || opt.copies < 1
+        || opt.server.period_frames < 1 || opt.server.capacity <= us{0}) {
+        usage(argv[0]);
+        return 1;
+    }
+    if (opt.num_cores == 0) {
+        opt.num_cores = preemptive ? 1 : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    if (!tsc) {
+        return run_demo<Clock>(opt, cfg);
+    }
+    if (!TscClock::calibrate()) {
+        std::cerr << "[WARN] No invariant TSC, --clock tsc falls back to steady_clock\n";
+    }
+    std::cout << "Clock: " << (TscClock::usable() ? "invariant TSC" : "steady_clock")
+              << std::fixed << std::setprecision(0) << " (" << TscClock::mhz() << " MHz)"
+              << " now() cost: tsc=" << std::setprecision(1) << now_cost_ns<TscClock>()
+              << " ns, steady=" << now_cost_ns<Clock>() << " ns\n";
+    return run_demo<TscClock>(opt, cfg);
+}
@@ -0,0 +1,166 @@
+/**
+ * Admission control: reject a task set before it runs rather than find out
+ * from overruns and frame slips.
+ *
+ * All tests use each task's wcet_budget (hand-set, or adopted from
+ * profile_wcet()) with implicit deadlines (deadline = period):
+ *   admit_frames - cyclic executive: U <= 1 and, since every release lands on
+ *                  a frame boundary, the budgets released in each frame fit the
+ *                  minor cycle (the build_schedule() check). Exact for frames.
+ *   admit_edf    - 1 CPU: U <= 1 (exact). m CPUs (global): U <= m - (m-1)Umax
+ *                  (Goossens-Funk-Baruah, sufficient only).
+ *   admit_rm     - 1 CPU: response-time analysis, R = C + sum ceil(R/Tj) Cj over
+ *                  the shorter-period tasks, iterated to a fixed point (exact
+ *                  for fully preemptive fixed priorities). m CPUs (global):
+ *                  U <= m^2/(3m-2) with every Ui <= m/(3m-2)
+ *                  (Andersson-Baruah-Jonsson, sufficient only).
+ * Passing a sufficient-only test guarantees the deadlines; failing it does
+ * not prove they will be missed.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "executive.hpp"
+#include "schedule_table.hpp"
+
+namespace cyclic {
+
+struct Admission {
+    const char* test = "";                  // which analysis decided
+    double utilisation = 0.0;
+    std::vector<long long> response_us;     // per task, filled by the RM analysis only
+    std::string error;                      // empty if the task set was admitted
+
+    bool ok() const { return error.empty(); }
+};
+
+inline double total_utilisation(const std::vector<Task*>& tasks) {
+    double u = 0.0;
+    for (const Task* t : tasks) {
+        u += t->utilisation();
+    }
+    return u;
+}
+
+inline std::string format_utilisation(double u) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << u;
+    return out.str();
+}
+
+/**
+ * @brief Cyclic executive on one core: utilisation and per-frame budgets.
+ */
+inline Admission admit_frames(const std::vector<Task*>& tasks, const ExecConfig& cfg) {
+    Admission a;
+    a.test = "frame budgets";
+    a.utilisation = total_utilisation(tasks);
+    if (a.utilisation > 1.0) {
+        a.error = "U=" + format_utilisation(a.utilisation) + " exceeds one core";
+        return a;
+    }
+    a.error = build_schedule(tasks, cfg).error;
+    return a;
+}
+
+/**
+ * @brief Preemptive EDF on 'cpus' CPUs.
+ */
+inline Admission admit_edf(const std::vector<Task*>& tasks, unsigned cpus) {
+    Admission a;
+    a.utilisation = total_utilisation(tasks);
+    if (cpus <= 1) {
+        a.test = "EDF utilisation";
+        if (a.utilisation > 1.0) {
+            a.error = "U=" + format_utilisation(a.utilisation) + " > 1";
+        }
+        return a;
+    }
+    a.test = "global EDF (GFB bound)";
+    double u_max = 0.0;
+    for (const Task* t : tasks) {
+        u_max = std::max(u_max, t->utilisation());
+    }
+    const double bound = cpus - (cpus - 1) * u_max;
+    if (a.utilisation > bound) {
+        a.error = "U=" + format_utilisation(a.utilisation) + " > " + format_utilisation(bound)
+                + " = m - (m-1)Umax";
+    }
+    return a;
+}
+
+/**
+ * @brief Worst-case response time of each task under rate-monotonic priorities
+ *        on one CPU, in us (task order). -1 where the iteration passes the
+ *        task's deadline.
+ */
+inline std::vector<long long> rm_response_times(const std::vector<Task*>& tasks) {
+    std::vector<long long> response(tasks.size(), -1);
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        const long long deadline = std::chrono::duration_cast<us>(tasks[i]->period).count();
+        long long r = tasks[i]->wcet_budget.count();
+        for (;;) {
+            long long next = tasks[i]->wcet_budget.count();
+            for (std::size_t j = 0; j < tasks.size(); ++j) {
+                // Higher priority: shorter period, ties broken by position
+                const bool higher = tasks[j]->period < tasks[i]->period
+                                 || (tasks[j]->period == tasks[i]->period && j < i);
+                if (higher) {
+                    const long long tj = std::chrono::duration_cast<us>(tasks[j]->period).count();
+                    next += (r + tj - 1) / tj * tasks[j]->wcet_budget.count();
+                }
+            }
+            if (next > deadline) {
+                break;
+            }
+            if (next == r) {
+                response[i] = r;
+                break;
+            }
+            r = next;
+        }
+    }
+    return response;
+}
+
+/**
+ * @brief Preemptive rate-monotonic on 'cpus' CPUs.
+ */
+inline Admission admit_rm(const std::vector<Task*>& tasks, unsigned cpus) {
+    Admission a;
+    a.utilisation = total_utilisation(tasks);
+    if (cpus <= 1) {
+        a.test = "RM response-time analysis";
+        a.response_us = rm_response_times(tasks);
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            if (a.response_us[i] < 0) {
+                a.error = tasks[i]->name + ": response time exceeds its period";
+                return a;
+            }
+        }
+        return a;
+    }
+    a.test = "global RM (ABJ bound)";
+    const double m = cpus;
+    const double u_cap = m / (3.0 * m - 2.0);
+    for (const Task* t : tasks) {
+        if (t->utilisation() > u_cap) {
+            a.error = t->name + ": Ui=" + format_utilisation(t->utilisation()) + " > m/(3m-2)";
+            return a;
+        }
+    }
+    if (a.utilisation > m * u_cap) {
+        a.error = "U=" + format_utilisation(a.utilisation) + " > m^2/(3m-2)=" + format_utilisation(m * u_cap);
+    }
+    return a;
+}
+
+} // namespace cyclic
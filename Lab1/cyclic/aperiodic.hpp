@@ -0,0 +1,191 @@
+/**
+ * Aperiodic server: run event-driven jobs in the cyclic executive's frame slack.
+ *
+ * Any thread may submit() a job (a callable plus its declared worst-case
+ * cost) into a bounded lock-free queue, Vyukov's sequence-numbered ring as
+ * in async_log, without locks or allocation. At the end of each frame, after
+ * its periodic tasks and before waiting for the boundary, the executive calls
+ * serve(): jobs are taken in FIFO order for as long as
+ *   - the server still has capacity left in its period, and
+ *   - the head job's declared cost plus a guard band ends before the next
+ *     frame boundary,
+ * so periodic releases are never pushed back by aperiodic work (a job that
+ * overruns its declared cost shows up as an aperiodic overrun and, if it runs
+ * into the boundary, as a frame slip). A job that does not fit waits for a
+ * later frame; jobs behind it wait too, which keeps the order FIFO. So that
+ * the head can always fit eventually, submit() rejects a job whose cost is
+ * above the capacity or, when the frame length is configured, above a whole
+ * frame minus the guard band.
+ *
+ * Capacity is replenished every period_frames frames:
+ *   Polling    - if the server finds the queue empty it gives up the rest of
+ *                its capacity until the next replenishment
+ *   Deferrable - unused capacity is kept until the next replenishment, so a
+ *                job arriving later in the period can still be served in it
+ *
+ * Exactly one executive thread may serve() a given server (the queue is
+ * multi-producer, single-consumer); producers only touch the queue and two
+ * counters.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "clock.hpp"
+#include "histogram.hpp"
+#include "inplace_function.hpp"
+
+namespace cyclic {
+
+enum class ServerKind { Polling, Deferrable };
+
+struct ServerConfig {
+    ServerKind kind = ServerKind::Polling;
+    us capacity{10000};         // execution time per replenishment period
+    int period_frames = 5;      // replenishment period, in minor frames (at 1 the
+                                // two kinds behave the same)
+    us guard{200};              // keep this much of the frame free before the boundary
+    us frame{0};                // minor frame length; 0 = jobs are not checked against it
+};
+
+/**
+ * @brief Statistics of the aperiodic class. Written only by the serving
+ *        executive, except 'submitted' and 'rejected'.
+ */
+struct AperiodicStats {
+    std::atomic<std::uint64_t> submitted{0};
+    std::atomic<std::uint64_t> rejected{0};     // queue full, or cost above the capacity or frame
+    std::uint64_t completed = 0;
+    std::uint64_t overruns = 0;                 // ran longer than the declared cost
+    long long busy_us = 0;                      // total execution time
+    Histogram response_hist;                    // submit -> completion, us
+    Histogram exec_hist;
+};
+
+class AperiodicServer {
+    public:
+        using Work = inplace_function<void()>;
+
+        static constexpr std::size_t CAPACITY = 1024;  // queued jobs, power of two
+
+        explicit AperiodicServer(ServerConfig cfg = {}) : cfg_(cfg), slots_(CAPACITY) {
+            for (std::size_t i = 0; i < CAPACITY; ++i) {
+                slots_[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        AperiodicServer(const AperiodicServer&) = delete;
+        AperiodicServer& operator=(const AperiodicServer&) = delete;
+
+        const ServerConfig& config() const { return cfg_; }
+        const AperiodicStats& stats() const { return stats_; }
+
+        // Jobs submitted but neither served nor rejected yet
+        std::uint64_t backlog() const {
+            return stats_.submitted.load(std::memory_order_relaxed)
+                 - stats_.rejected.load(std::memory_order_relaxed) - stats_.completed;
+        }
+
+        /**
+         * @brief Queue 'work' with declared worst-case cost 'cost'. Lock-free,
+         *        callable from any thread.
+         * @return false if the queue is full or 'cost' can never fit the capacity
+         *         or a frame.
+         */
+        bool submit(Work work, us cost) {
+            stats_.submitted.fetch_add(1, std::memory_order_relaxed);
+            if (cost > cfg_.capacity || (cfg_.frame > us{0} && cost > cfg_.frame - cfg_.guard)) {
+                stats_.rejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            std::size_t pos = tail_.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& slot = slots_[pos & (CAPACITY - 1)];
+                const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+                const auto dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (dif == 0) {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        slot.work = std::move(work);
+                        slot.cost = cost;
+                        slot.submitted = Clock::now();
+                        slot.seq.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (dif < 0) {
+                    // Full: the executive has not served this slot yet
+                    stats_.rejected.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                } else {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Serve queued jobs until capacity, the queue or the time before
+         *        'boundary' (minus the guard band) runs out. Executive thread only.
+         */
+        template <typename C = Clock>
+        void serve(Clock::time_point boundary) {
+            if (frames_++ % std::max(cfg_.period_frames, 1) == 0) {
+                budget_us_ = std::chrono::duration_cast<us>(cfg_.capacity).count();
+            }
+            const auto deadline = boundary - cfg_.guard;
+            while (budget_us_ > 0) {
+                Slot& slot = slots_[head_ & (CAPACITY - 1)];
+                if (slot.seq.load(std::memory_order_acquire) != head_ + 1) {
+                    if (cfg_.kind == ServerKind::Polling) {
+                        budget_us_ = 0; // nothing pending at the poll: capacity is lost
+                    }
+                    return;
+                }
+                const long long cost_us = slot.cost.count();
+                if (cost_us > budget_us_ || C::now() + slot.cost > deadline) {
+                    return; // head job waits for a frame with room for it
+                }
+
+                const auto start = C::now();
+                slot.work();
+                const auto end = C::now();
+                slot.work = Work{};
+                const Clock::time_point submitted = slot.submitted;
+                slot.seq.store(head_ + CAPACITY, std::memory_order_release);
+                ++head_;
+
+                const long long exec_us = std::chrono::duration_cast<us>(end - start).count();
+                budget_us_ -= std::max(exec_us, cost_us);
+                stats_.completed++;
+                stats_.busy_us += exec_us;
+                if (exec_us > cost_us) {
+                    stats_.overruns++;
+                }
+                stats_.exec_hist.record(exec_us);
+                stats_.response_hist.record(std::chrono::duration_cast<us>(end - submitted).count());
+            }
+        }
+
+    private:
+        struct alignas(64) Slot {
+            std::atomic<std::size_t> seq{0};
+            us cost{0};
+            Clock::time_point submitted{};
+            Work work;
+        };
+
+        ServerConfig cfg_;
+        std::vector<Slot> slots_;
+        alignas(64) std::atomic<std::size_t> tail_{0};      // next slot to claim (producers)
+        alignas(64) std::size_t head_ = 0;                  // next slot to serve (executive only)
+        std::uint64_t frames_ = 0;
+        long long budget_us_ = 0;
+        AperiodicStats stats_;
+};
+
+} // namespace cyclic
@@ -0,0 +1,172 @@
+/**
+ * Clock types shared by the cyclic executive headers.
+ *
+ * The executive's timing functions are templated on a clock policy C, which
+ * only needs a static C::now() returning a Clock::time_point:
+ *   Clock    - std::chrono::steady_clock (the default)
+ *   TscClock - the x86 time-stamp counter read with rdtscp, converted to
+ *              steady_clock time with a ratio calibrated at startup
+ * Because TscClock hands out ordinary steady_clock time points, tasks, stats
+ * and sleep_until() are unchanged; only the reads get cheaper.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CYCLIC_HAVE_TSC 1
+#include <immintrin.h> // For _mm_pause
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h> // For __rdtscp
+#endif
+#endif
+
+namespace cyclic {
+
+// Type aliases for clarity
+using Clock = std::chrono::steady_clock;
+using ms = std::chrono::milliseconds;
+using us = std::chrono::microseconds;
+
+/**
+ * @brief Spin-wait hint: tells the core we are busy-waiting, which saves
+ *        power and gives the sibling hyper-thread the pipeline.
+ */
+inline void cpu_relax() {
+#if defined(CYCLIC_HAVE_TSC)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ * @brief Invariant-TSC clock policy.
+ *
+ * calibrate() measures TSC ticks against steady_clock over a short window and
+ * anchors the two together; it must run before any thread uses now(). Reads
+ * use rdtscp, which waits for earlier instructions to finish, so a timestamp
+ * taken after a task body is not hoisted into it. If the CPU does not
+ * advertise an invariant TSC (constant rate across P-states, not stopped in
+ * deep C-states), or this is not x86, now() falls back to steady_clock.
+ */
+class TscClock {
+    public:
+        using duration = Clock::duration;
+        using rep = Clock::rep;
+        using period = Clock::period;
+        using time_point = Clock::time_point;
+        static constexpr bool is_steady = true;
+
+        // Does the CPU advertise an invariant TSC?
+        static bool invariant() {
+#if defined(CYCLIC_HAVE_TSC) && defined(_MSC_VER)
+            int regs[4];
+            __cpuid(regs, 0x80000000);
+            if (static_cast<unsigned>(regs[0]) < 0x80000007u) {
+                return false;
+            }
+            __cpuid(regs, 0x80000007);
+            return (regs[3] & (1 << 8)) != 0;
+#elif defined(CYCLIC_HAVE_TSC)
+            unsigned a = 0, b = 0, c = 0, d = 0;
+            if (__get_cpuid_max(0x80000000u, nullptr) < 0x80000007u) {
+                return false;
+            }
+            __get_cpuid(0x80000007u, &a, &b, &c, &d);
+            return (d & (1u << 8)) != 0;
+#else
+            return false;
+#endif
+        }
+
+        /**
+         * @brief Calibrate against steady_clock over 'window'.
+         * @return true if the TSC is in use, false if now() falls back.
+         */
+        static bool calibrate(ms window = ms{50}) {
+            State& s = state();
+            s.usable = false;
+            if (!invariant()) {
+                return false;
+            }
+            const auto [c0, t0] = anchor();
+            std::this_thread::sleep_for(window);
+            const auto [c1, t1] = anchor();
+            s.ns_per_tick = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count())
+                          / static_cast<double>(c1 - c0);
+            s.tsc_base = c1;
+            s.base = t1;
+            s.usable = true;
+            return true;
+        }
+
+        static bool usable() { return state().usable; }
+
+        // Ticks per microsecond, i.e. the TSC rate in MHz (0 if unused)
+        static double mhz() { return usable() ? 1000.0 / state().ns_per_tick : 0.0; }
+
+        static time_point now() noexcept {
+            const State& s = state();
+            if (!s.usable) {
+                return Clock::now();
+            }
+            // Signed: a core whose TSC lags the calibrating core's can read
+            // slightly below tsc_base, which must give a time just before base
+            // rather than wrap to ~2^64 ticks in the future.
+            const auto ticks = static_cast<std::int64_t>(read() - s.tsc_base);
+            const double ns = static_cast<double>(ticks) * s.ns_per_tick;
+            return s.base + std::chrono::duration_cast<duration>(std::chrono::nanoseconds(static_cast<long long>(ns)));
+        }
+
+    private:
+        struct State {
+            bool usable = false;
+            double ns_per_tick = 0.0;
+            std::uint64_t tsc_base = 0;
+            time_point base{};
+        };
+
+        static State& state() {
+            static State s;
+            return s;
+        }
+
+        static std::uint64_t read() noexcept {
+#if defined(CYCLIC_HAVE_TSC)
+            unsigned aux;
+            return __rdtscp(&aux);
+#else
+            return 0;
+#endif
+        }
+
+        struct Anchor {
+            std::uint64_t tsc;
+            time_point steady;
+        };
+
+        // A (TSC, steady) pair read back to back; keep the tightest of a few tries
+        static Anchor anchor() {
+            Anchor best{};
+            std::uint64_t best_gap = ~std::uint64_t{0};
+            for (int i = 0; i < 16; ++i) {
+                const std::uint64_t before = read();
+                const time_point t = Clock::now();
+                const std::uint64_t after = read();
+                if (after - before < best_gap) {
+                    best_gap = after - before;
+                    best = {before + (after - before) / 2, t};
+                }
+            }
+            return best;
+        }
+};
+
+} // namespace cyclic
@@ -0,0 +1,386 @@
+/**
+ * Cyclic executive core: tasks, statistics and the time-triggered frame loop
+ * used by advanced.cpp.
+ *
+ * The loop is the one from the original single-file example: every minor
+ * cycle it releases the tasks whose next_release has passed, runs them to
+ * completion, records release jitter / execution time / budget overruns and
+ * then sleeps until the next frame boundary.
+ *
+ * Besides the worst cases, jitter, execution time and per-frame busy time
+ * (minor cycle minus slack) go into fixed-memory histograms, reported as
+ * p50/p90/p99/p99.9/max at the end, optionally every few major cycles, and
+ * exportable as CSV for diffing runs.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cmath> // For std::llabs
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "aperiodic.hpp"
+#include "clock.hpp"
+#include "frame_wait.hpp"
+#include "histogram.hpp"
+#include "inplace_function.hpp"
+
+namespace cyclic {
+
+// --- Utilities to simulate work and measure timing ---
+
+/**
+ * @brief Cooperative preemption hook. The preemptive dispatcher installs one
+ *        per worker thread; everywhere else it is empty and costs one load.
+ *        'fn' returns how long the caller was parked for.
+ */
+struct PreemptionHook {
+    Clock::duration (*fn)(void*) = nullptr;
+    void* ctx = nullptr;
+};
+
+inline thread_local PreemptionHook preemption_hook;
+
+/**
+ * @brief Let a higher-priority job run if one is waiting for this CPU.
+ *        Long task bodies call it periodically.
+ * @return Time spent parked (zero if not preempted).
+ */
+inline Clock::duration preemption_point() {
+    return preemption_hook.fn != nullptr ? preemption_hook.fn(preemption_hook.ctx) : Clock::duration::zero();
+}
+
+/**
+ * @brief Simulate work by spinning for a target number of microseconds.
+ *        Time parked at a preemption point does not count as work.
+ * @tparam C Clock policy used to time the spin (see clock.hpp).
+ * @param target_us The approximate number of microseconds to spin.
+ */
+template <typename C = Clock>
+inline void busy_work_us(int target_us) {
+    auto start = C::now();
+    while (std::chrono::duration_cast<us>(C::now() - start).count() < target_us) {
+        start += preemption_point();
+        // This loop intentionally consumes CPU to simulate execution time.
+        // In a real x86 system, you might use _mm_pause() here
+        // to be friendlier to hyper-threading.
+    }
+}
+
+/**
+ * @brief Holds execution statistics for a single task.
+ */
+struct RunStats {
+    int runs = 0;
+    long long worst_jitter_us = 0;
+    long long worst_exec_us = 0;
+    int overruns = 0;
+    long long worst_response_us = 0;    // release -> completion
+    int deadline_misses = 0;            // completed after release + period
+    Histogram jitter_hist;              // |release jitter|, us
+    Histogram exec_hist;                // execution time, us
+};
+
+/**
+ * @brief Defines a single periodic task for the executive.
+ */
+struct Task {
+    std::string name;
+    ms period;              // How often to execute
+    ms phase{0};            // Initial delay before first release
+    us wcet_budget;         // Execution budget (microseconds)
+    inplace_function<void()> work; // The task body (stored inline, never allocates)
+    Clock::time_point next_release{}; // When the task is next due
+    RunStats stats{};
+
+    // Fraction of one CPU the task needs at its budget
+    double utilisation() const {
+        return static_cast<double>(wcet_budget.count())
+             / static_cast<double>(std::chrono::duration_cast<us>(period).count());
+    }
+};
+
+/**
+ * @brief How an executive decides which tasks run in a frame.
+ *   Scan  - compare every task's next_release against the clock (original loop)
+ *   Table - index a precomputed frame -> task-list table (schedule_table.hpp)
+ *   Wheel - expire releases from a hierarchical timing wheel (timing_wheel.hpp)
+ */
+enum class Dispatch { Scan, Table, Wheel };
+
+/**
+ * @brief Per-executive frame statistics. Slack is the time left in a frame
+ *        after its tasks have run (negative = the frame overran).
+ */
+struct FrameStats {
+    int frames = 0;
+    int slips = 0;                      // wake-ups later than slip_tolerance
+    long long min_slack_us = 0;
+    long long total_slack_us = 0;
+    Histogram busy_hist;                // minor cycle - slack, us
+    WaitStats wait;                     // frame-boundary wait cost
+
+    double mean_slack_us() const {
+        return frames > 0 ? static_cast<double>(total_slack_us) / frames : 0.0;
+    }
+};
+
+/**
+ * @brief Executive timing parameters.
+ */
+struct ExecConfig {
+    ms minor_cycle{10};     // 10 ms frame
+    ms major_cycle{100};    // 100 ms (10 frames)
+    int major_cycles_to_run = 5; // demo runtime ≈ 0.5 s
+    ms slip_tolerance{1};   // Allowable slip before warning
+    Dispatch dispatch = Dispatch::Scan;
+    WaitMode wait = WaitMode::Sleep;    // how to wait for the frame boundary
+
+    // Every 'snapshot_every' major cycles (0 = never) the executive thread calls
+    // on_snapshot(tasks, frames, label) at the end of the frame, before sleeping
+    int snapshot_every = 0;
+    std::function<void(const std::vector<Task*>&, const FrameStats&, const std::string&)> on_snapshot;
+
+    // If set, aperiodic jobs run in each frame's slack (aperiodic.hpp); only
+    // one executive may serve a given server
+    AperiodicServer* server = nullptr;
+};
+
+/**
+ * @brief Record one completed job of a task with 'budget' and 'period'.
+ * @param jitter_us   Lateness of the release against its scheduled instant.
+ * @param exec_us     Execution time of the body.
+ * @param response_us Scheduled release to completion; a response longer than
+ *                    the period is a deadline miss (implicit deadlines).
+ */
+inline void record_run(RunStats& stats, us budget, ms period,
+                       long long jitter_us, long long exec_us, long long response_us) {
+    // Measure release jitter vs exact schedule point
+    if (std::llabs(jitter_us) > stats.worst_jitter_us) {
+        stats.worst_jitter_us = std::llabs(jitter_us);
+    }
+
+    // Update execution stats
+    if (exec_us > stats.worst_exec_us) {
+        stats.worst_exec_us = exec_us;
+    }
+    if (exec_us > budget.count()) {
+        stats.overruns++;
+    }
+    if (response_us > stats.worst_response_us) {
+        stats.worst_response_us = response_us;
+    }
+    if (response_us > std::chrono::duration_cast<us>(period).count()) {
+        stats.deadline_misses++;
+    }
+    stats.runs++;
+
+    stats.jitter_hist.record(std::llabs(jitter_us));
+    stats.exec_hist.record(exec_us);
+}
+
+inline void record_run(Task& t, long long jitter_us, long long exec_us, long long response_us) {
+    record_run(t.stats, t.wcet_budget, t.period, jitter_us, exec_us, response_us);
+}
+
+/**
+ * @brief Run one released task to completion and record its statistics.
+ * @param release The task's scheduled release instant.
+ * @param now     When the executive picked the release up (start of frame).
+ */
+template <typename C = Clock>
+inline void dispatch(Task& t, Clock::time_point release, Clock::time_point now) {
+    // Execute task and measure execution time
+    const auto exec_start = C::now();
+    t.work();
+    const auto exec_end = C::now();
+
+    record_run(t, std::chrono::duration_cast<us>(now - release).count(),
+               std::chrono::duration_cast<us>(exec_end - exec_start).count(),
+               std::chrono::duration_cast<us>(exec_end - release).count());
+}
+
+/**
+ * @brief Record the frame's slack, serve aperiodic jobs in it (if there is a
+ *        server), then sleep until 'frame_start' (the next frame boundary) and
+ *        warn if the wake-up slipped.
+ */
+template <typename C = Clock>
+inline void end_frame(FrameStats& fs, FrameWaiter& waiter, const std::vector<Task*>& tasks,
+                      Clock::time_point frame_start, const ExecConfig& cfg, const std::string& label) {
+    const auto slack_us = std::chrono::duration_cast<us>(frame_start - C::now()).count();
+    fs.frames++;
+    fs.total_slack_us += slack_us;
+    if (slack_us < fs.min_slack_us) {
+        fs.min_slack_us = slack_us;
+    }
+    fs.busy_hist.record(std::chrono::duration_cast<us>(cfg.minor_cycle).count() - slack_us);
+
+    if (cfg.snapshot_every > 0 && cfg.on_snapshot
+        && fs.frames % (cfg.snapshot_every * (cfg.major_cycle / cfg.minor_cycle)) == 0) {
+        cfg.on_snapshot(tasks, fs, label);
+    }
+
+    if (cfg.server != nullptr) {
+        cfg.server->serve<C>(frame_start);
+    }
+
+    waiter.wait_until<C>(frame_start, fs.wait);
+
+    // Optional: detect frame overrun (if tasks exceeded frame budget)
+    auto after_sleep = C::now();
+    if (after_sleep > frame_start + cfg.slip_tolerance) {
+        auto slip = std::chrono::duration_cast<us>(after_sleep - frame_start).count();
+        fs.slips++;
+        // Use std::cerr for warnings; one write per line so cores do not interleave
+        std::ostringstream warn;
+        warn << (label.empty() ? "" : "[" + label + "] ")
+             << "[WARN] Frame overrun: slipped by " << slip << " us\n";
+        std::cerr << warn.str();
+    }
+}
+
+inline FrameStats start_frames(const ExecConfig& cfg) {
+    FrameStats fs;
+    fs.min_slack_us = std::chrono::duration_cast<us>(cfg.minor_cycle).count();
+    return fs;
+}
+
+/**
+ * @brief Run one time-triggered executive over 'tasks' until t0 + major cycles.
+ * @param tasks Tasks owned by this executive (next_release is initialised here).
+ * @param cfg   Frame timing.
+ * @param t0    Epoch: frame k starts at t0 + k * minor_cycle. Executives on
+ *              different cores given the same t0 have aligned frames.
+ * @param label Prefix for warnings (e.g. "core 2"), empty for none.
+ * @tparam C    Clock policy for every timestamp the executive takes.
+ */
+template <typename C = Clock>
+inline FrameStats run_executive(const std::vector<Task*>& tasks, const ExecConfig& cfg,
+                                Clock::time_point t0, const std::string& label = "") {
+    // Initialise next releases relative to executive start
+    for (auto* t : tasks) {
+        t->next_release = t0 + t->phase;
+    }
+
+    FrameStats fs = start_frames(cfg);
+    FrameWaiter waiter(cfg.wait);
+
+    waiter.wait_until<C>(t0, fs.wait);
+    auto frame_start = t0;
+    const auto end_time = t0 + cfg.major_cycle * cfg.major_cycles_to_run;
+
+    // --- Main Executive Loop ---
+    while (C::now() < end_time) {
+        // 1) Release and execute due tasks within this frame
+        auto now = C::now();
+        for (auto* tp : tasks) {
+            Task& t = *tp;
+            if (now >= t.next_release) {
+                dispatch<C>(t, t.next_release, now);
+
+                // Schedule next release (strict periodic)
+                t.next_release += t.period;
+
+                // Catch up if we slipped multiple periods
+                while (t.next_release < now) {
+                    t.next_release += t.period;
+                }
+            }
+        }
+
+        // 2) Wait for the next frame boundary (sleep, or sleep then spin)
+        frame_start += cfg.minor_cycle;
+        end_frame<C>(fs, waiter, tasks, frame_start, cfg, label);
+    }
+    return fs;
+}
+
+/**
+ * @brief Print one task's report line.
+ */
+inline void print_task_line(const std::string& name, const RunStats& stats, std::ostream& out = std::cout) {
+    out << "Task " << std::left << std::setw(10) << name
+        << " runs=" << std::setw(4) << stats.runs
+        << " worst_jitter=" << std::setw(6) << stats.worst_jitter_us << " us"
+        << " worst_exec=" << std::setw(6) << stats.worst_exec_us << " us"
+        << " overruns=" << std::setw(3) << stats.overruns
+        << " worst_resp=" << std::setw(6) << stats.worst_response_us << " us"
+        << " misses=" << stats.deadline_misses
+        << std::right << "\n";
+}
+
+/**
+ * @brief Print the per-task report lines.
+ */
+inline void print_task_report(const std::vector<Task*>& tasks, std::ostream& out = std::cout) {
+    for (const auto* tp : tasks) { // Use const* for read-only access
+        print_task_line(tp->name, tp->stats, out);
+    }
+}
+
+/**
+ * @brief Print p50/p90/p99/p99.9/max for each task's jitter and execution
+ *        time and, if given, the frame slack (low percentiles of slack are
+ *        the high percentiles of busy time).
+ */
+inline void print_percentile_row(const std::string& what, const Histogram& h, std::ostream& out = std::cout) {
+    out << "  " << std::left << std::setw(22) << what << std::right
+        << " p50=" << std::setw(6) << h.percentile(50)
+        << " p90=" << std::setw(6) << h.percentile(90)
+        << " p99=" << std::setw(6) << h.percentile(99)
+        << " p99.9=" << std::setw(6) << h.percentile(99.9)
+        << " max=" << std::setw(6) << h.max() << " us\n";
+}
+
+inline void print_percentile_report(const std::vector<Task*>& tasks, const FrameStats* fs,
+                                    const ExecConfig& cfg, std::ostream& out = std::cout) {
+    for (const auto* tp : tasks) {
+        print_percentile_row(tp->name + " jitter", tp->stats.jitter_hist, out);
+        print_percentile_row(tp->name + " exec", tp->stats.exec_hist, out);
+    }
+    if (fs != nullptr && fs->busy_hist.count() > 0) {
+        const long long minor_us = std::chrono::duration_cast<us>(cfg.minor_cycle).count();
+        const Histogram& h = fs->busy_hist;
+        out << "  " << std::left << std::setw(22) << "frame slack" << std::right
+            << " p50=" << std::setw(6) << minor_us - h.percentile(50)
+            << " p10=" << std::setw(6) << minor_us - h.percentile(90)
+            << " p1=" << std::setw(6) << minor_us - h.percentile(99)
+            << " p0.1=" << std::setw(6) << minor_us - h.percentile(99.9)
+            << " min=" << std::setw(6) << minor_us - h.max() << " us\n";
+    }
+}
+
+inline void write_stats_csv_header(std::ostream& out) {
+    out << "scope,task,metric,count,p50_us,p90_us,p99_us,p99_9_us,max_us\n";
+}
+
+/**
+ * @brief One CSV row per task and metric (jitter, exec) plus one for frame
+ *        busy time (minor cycle - slack) if 'fs' is given.
+ */
+inline void write_stats_csv_row(std::ostream& out, const std::string& scope, const std::string& task,
+                                const char* metric, const Histogram& h) {
+    out << scope << ',' << task << ',' << metric << ',' << h.count()
+        << ',' << h.percentile(50) << ',' << h.percentile(90) << ',' << h.percentile(99)
+        << ',' << h.percentile(99.9) << ',' << h.max() << '\n';
+}
+
+inline void write_stats_csv(std::ostream& out, const std::string& scope,
+                            const std::vector<Task*>& tasks, const FrameStats* fs) {
+    for (const auto* tp : tasks) {
+        write_stats_csv_row(out, scope, tp->name, "jitter", tp->stats.jitter_hist);
+        write_stats_csv_row(out, scope, tp->name, "exec", tp->stats.exec_hist);
+    }
+    if (fs != nullptr) {
+        write_stats_csv_row(out, scope, "", "frame_busy", fs->busy_hist);
+    }
+}
+
+} // namespace cyclic
@@ -0,0 +1,84 @@
+/**
+ * Frame-boundary wait strategies for the cyclic executive.
+ *
+ *   Sleep  - std::this_thread::sleep_until(boundary), as in the original loop.
+ *            Wake-up lateness is whatever the kernel's timer slack and
+ *            scheduling latency happen to be (typically 50-100+ us).
+ *   Hybrid - sleep until a margin before the boundary, then spin with
+ *            cpu_relax() for the final stretch. The margin adapts to the
+ *            oversleep actually observed: it jumps up as soon as a sleep
+ *            overshoots into the margin and decays slowly otherwise, so the
+ *            spin stays as short as the machine allows.
+ *
+ * Hybrid trades CPU for release jitter; WaitStats records how much time was
+ * spent spinning so the two can be compared.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "clock.hpp"
+
+namespace cyclic {
+
+enum class WaitMode { Sleep, Hybrid };
+
+struct WaitStats {
+    long long spin_us = 0;          // total time spent spinning
+    int late_wakeups = 0;           // sleeps that overshot the whole margin
+    long long margin_us = 0;        // margin at the end of the run
+};
+
+class FrameWaiter {
+    public:
+        static constexpr us MIN_MARGIN{20};
+        static constexpr us MAX_MARGIN{2000};
+        static constexpr us INITIAL_MARGIN{200};
+
+        explicit FrameWaiter(WaitMode mode) : mode_(mode) {}
+
+        template <typename C = Clock>
+        void wait_until(Clock::time_point boundary, WaitStats& stats) {
+            if (mode_ == WaitMode::Sleep) {
+                std::this_thread::sleep_until(boundary);
+                return;
+            }
+
+            const auto wake_at = boundary - margin_;
+            if (C::now() < wake_at) {
+                std::this_thread::sleep_until(wake_at);
+                const auto oversleep = C::now() - wake_at;
+                if (oversleep >= margin_) {
+                    stats.late_wakeups++;
+                }
+                adapt(oversleep);
+            }
+
+            const auto spin_start = C::now();
+            while (C::now() < boundary) {
+                cpu_relax();
+            }
+            stats.spin_us += std::chrono::duration_cast<us>(C::now() - spin_start).count();
+            stats.margin_us = std::chrono::duration_cast<us>(margin_).count();
+        }
+
+    private:
+        WaitMode mode_;
+        Clock::duration margin_ = INITIAL_MARGIN;
+
+        // Keep the margin ~25% above the oversleep seen: grow at once, shrink by 1/16 per frame
+        void adapt(Clock::duration oversleep) {
+            const Clock::duration want = oversleep + oversleep / 4 + MIN_MARGIN;
+            if (want > margin_) {
+                margin_ = want;
+            } else {
+                margin_ -= (margin_ - want) / 16;
+            }
+            margin_ = std::clamp<Clock::duration>(margin_, MIN_MARGIN, MAX_MARGIN);
+        }
+};
+
+} // namespace cyclic
@@ -0,0 +1,103 @@
+/**
+ * Fixed-memory log-linear (HDR-style) histogram for timing samples in us.
+ *
+ * Values below 2^SUB_BITS get a bucket each; above that every power of two
+ * is split into 2^SUB_BITS equal sub-buckets, so any recorded value is known
+ * to within 1/32 (about 3%) however large it is. All counters live in one
+ * std::array: record() is a bit_width, a shift and an increment, and never
+ * allocates, so it can sit on the executive's hot path.
+ *
+ * Values are clamped to [0, 2^MAX_BITS) (about 19 hours in us).
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace cyclic {
+
+class Histogram {
+    public:
+        static constexpr unsigned SUB_BITS = 5;
+        static constexpr std::uint64_t SUB = std::uint64_t{1} << SUB_BITS;
+        static constexpr unsigned MAX_BITS = 36;
+        static constexpr std::size_t BUCKETS = SUB + (MAX_BITS - SUB_BITS) * SUB;
+
+        void record(long long value) noexcept {
+            std::uint64_t v = value < 0 ? 0 : static_cast<std::uint64_t>(value);
+            if (v >= (std::uint64_t{1} << MAX_BITS)) {
+                v = (std::uint64_t{1} << MAX_BITS) - 1;
+            }
+            counts_[index_of(v)]++;
+            count_++;
+            if (count_ == 1 || static_cast<long long>(v) < min_) {
+                min_ = static_cast<long long>(v);
+            }
+            if (static_cast<long long>(v) > max_) {
+                max_ = static_cast<long long>(v);
+            }
+        }
+
+        std::uint64_t count() const { return count_; }
+        long long min() const { return min_; }
+        long long max() const { return max_; }
+
+        /**
+         * @brief Smallest value that at least 'pct' percent of samples do not
+         *        exceed (to bucket precision, never above max()).
+         */
+        long long percentile(double pct) const {
+            if (count_ == 0) {
+                return 0;
+            }
+            auto target = static_cast<std::uint64_t>(pct / 100.0 * static_cast<double>(count_) + 0.999999);
+            if (target < 1) {
+                target = 1;
+            }
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < BUCKETS; ++i) {
+                seen += counts_[i];
+                if (seen >= target) {
+                    const long long upper = upper_of(i);
+                    return upper < max_ ? (upper > min_ ? upper : min_) : max_;
+                }
+            }
+            return max_;
+        }
+
+        void reset() {
+            counts_.fill(0);
+            count_ = 0;
+            min_ = 0;
+            max_ = 0;
+        }
+
+    private:
+        std::array<std::uint64_t, BUCKETS> counts_{};
+        std::uint64_t count_ = 0;
+        long long min_ = 0;
+        long long max_ = 0;
+
+        static std::size_t index_of(std::uint64_t v) {
+            if (v < SUB) {
+                return static_cast<std::size_t>(v);
+            }
+            const unsigned shift = static_cast<unsigned>(std::bit_width(v)) - 1 - SUB_BITS;
+            return static_cast<std::size_t>(SUB + shift * SUB + ((v >> shift) - SUB));
+        }
+
+        // Largest value that maps to bucket 'i'
+        static long long upper_of(std::size_t i) {
+            if (i < SUB) {
+                return static_cast<long long>(i);
+            }
+            const std::uint64_t shift = (i - SUB) / SUB;
+            const std::uint64_t sub = (i - SUB) % SUB;
+            return static_cast<long long>(((SUB + sub) << shift) + (std::uint64_t{1} << shift) - 1);
+        }
+};
+
+} // namespace cyclic
@@ -0,0 +1,112 @@
+/**
+ * inplace_function - a std::function that never allocates.
+ *
+ * The callable is stored in a fixed buffer inside the object; a callable that
+ * does not fit (or needs stricter alignment) is a compile error rather than a
+ * heap allocation. Calls go through one function pointer, copy/move/destroy
+ * through a small per-type table, so the executive's task bodies stay
+ * allocation-free however they are captured.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cyclic {
+
+template <typename Signature, std::size_t Capacity = 48>
+class inplace_function;
+
+template <typename R, typename... Args, std::size_t Capacity>
+class inplace_function<R(Args...), Capacity> {
+    public:
+        inplace_function() = default;
+
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, inplace_function>>>
+        inplace_function(F&& f) {
+            using T = std::decay_t<F>;
+            static_assert(sizeof(T) <= Capacity, "callable too large for inplace_function buffer");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "callable over-aligned for inplace_function");
+            static_assert(std::is_invocable_r_v<R, T&, Args...>, "callable has the wrong signature");
+            ::new (static_cast<void*>(buf_)) T(std::forward<F>(f));
+            invoke_ = [](void* p, Args... args) -> R {
+                return (*static_cast<T*>(p))(std::forward<Args>(args)...);
+            };
+            ops_ = &ops_for<T>;
+        }
+
+        inplace_function(const inplace_function& o) : invoke_(o.invoke_), ops_(o.ops_) {
+            if (ops_ != nullptr) {
+                ops_->copy(buf_, o.buf_);
+            }
+        }
+
+        inplace_function(inplace_function&& o) noexcept : invoke_(o.invoke_), ops_(o.ops_) {
+            if (ops_ != nullptr) {
+                ops_->move(buf_, o.buf_);
+            }
+        }
+
+        inplace_function& operator=(const inplace_function& o) {
+            if (this != &o) {
+                reset();
+                if (o.ops_ != nullptr) {
+                    o.ops_->copy(buf_, o.buf_);
+                }
+                invoke_ = o.invoke_;
+                ops_ = o.ops_;
+            }
+            return *this;
+        }
+
+        inplace_function& operator=(inplace_function&& o) noexcept {
+            if (this != &o) {
+                reset();
+                if (o.ops_ != nullptr) {
+                    o.ops_->move(buf_, o.buf_);
+                }
+                invoke_ = o.invoke_;
+                ops_ = o.ops_;
+            }
+            return *this;
+        }
+
+        ~inplace_function() { reset(); }
+
+        explicit operator bool() const { return invoke_ != nullptr; }
+
+        R operator()(Args... args) const {
+            return invoke_(const_cast<unsigned char*>(buf_), std::forward<Args>(args)...);
+        }
+
+    private:
+        struct Ops {
+            void (*copy)(void* dst, const void* src);
+            void (*move)(void* dst, void* src);
+            void (*destroy)(void* p);
+        };
+
+        template <typename T>
+        static constexpr Ops ops_for{
+            [](void* dst, const void* src) { ::new (dst) T(*static_cast<const T*>(src)); },
+            [](void* dst, void* src) { ::new (dst) T(std::move(*static_cast<T*>(src))); },
+            [](void* p) { static_cast<T*>(p)->~T(); },
+        };
+
+        alignas(std::max_align_t) unsigned char buf_[Capacity];
+        R (*invoke_)(void*, Args...) = nullptr;
+        const Ops* ops_ = nullptr;
+
+        void reset() {
+            if (ops_ != nullptr) {
+                ops_->destroy(buf_);
+            }
+            invoke_ = nullptr;
+            ops_ = nullptr;
+        }
+};
+
+} // namespace cyclic
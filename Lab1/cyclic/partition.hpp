@@ -0,0 +1,168 @@
+/**
+ * Partitioned multi-core cyclic executive.
+ *
+ * Tasks are bin-packed onto cores by utilisation (WCET budget / period) with
+ * first-fit decreasing, then each core runs its own time-triggered executive
+ * (run_executive) on a thread pinned to that CPU. Every core is handed the
+ * same epoch, so frame k starts at the same instant on all of them.
+ *
+ * Tasks never migrate, so each core is an independent uniprocessor schedule;
+ * the only thing shared between cores is the epoch. Fitting by utilisation
+ * alone is necessary but not sufficient: a core can still overload an
+ * individual frame when several of its tasks release together. Given the
+ * ExecConfig, partition_tasks() also runs the frame admission test for each
+ * placement, so a core only takes a task if all of its frames still fit, and
+ * tries the least-loaded core first (worst fit): frame budgets are a bin
+ * packing per frame, and spreading tasks leaves every core's frames the most
+ * room where first fit would fill frame 0 of core 0 and strand the rest.
+ * Each core's thread also profiles itself (CoreResult::counters), so per-core
+ * CPU time, context switches and cache misses can be compared.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "admission.hpp"
+#include "executive.hpp"
+#include "schedule_table.hpp"
+#include "timing_wheel.hpp"
+#include "../../common/affinity.hpp"
+#include "../../common/perf_counters.hpp"
+
+namespace cyclic {
+
+struct Partition {
+    std::vector<Task*> tasks;
+    double utilisation = 0.0;
+    ScheduleTable table;    // filled by build_tables() for Dispatch::Table
+};
+
+/**
+ * @brief First-fit decreasing bin-packing of 'tasks' onto 'cores' bins.
+ * @param capacity Utilisation bound per core (1.0 = a full CPU).
+ * @param frames If set, a task also has to pass admit_frames() on its core,
+ *               and cores are tried least-loaded first (worst-fit decreasing).
+ * @return One Partition per used core, or an empty vector if some task does not fit.
+ */
+inline std::vector<Partition> partition_tasks(std::vector<Task>& tasks, unsigned cores,
+                                              double capacity = 1.0, const ExecConfig* frames = nullptr) {
+    std::vector<Task*> order;
+    order.reserve(tasks.size());
+    for (auto& t : tasks) {
+        order.push_back(&t);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const Task* a, const Task* b) {
+        return a->utilisation() > b->utilisation();
+    });
+
+    std::vector<Partition> parts(cores);
+    std::vector<Partition*> tries;
+    for (auto& p : parts) {
+        tries.push_back(&p);
+    }
+    for (Task* t : order) {
+        if (frames != nullptr) {
+            std::stable_sort(tries.begin(), tries.end(), [](const Partition* a, const Partition* b) {
+                return a->utilisation < b->utilisation;
+            });
+        }
+        auto fits = std::find_if(tries.begin(), tries.end(), [&](const Partition* p) {
+            if (p->utilisation + t->utilisation() > capacity) {
+                return false;
+            }
+            if (frames == nullptr) {
+                return true;
+            }
+            std::vector<Task*> trial = p->tasks;
+            trial.push_back(t);
+            return admit_frames(trial, *frames).ok();
+        });
+        if (fits == tries.end()) {
+            return {};
+        }
+        (*fits)->tasks.push_back(t);
+        (*fits)->utilisation += t->utilisation();
+    }
+    // Cores left empty get no executive
+    parts.erase(std::remove_if(parts.begin(), parts.end(),
+                               [](const Partition& p) { return p.tasks.empty(); }),
+                parts.end());
+    return parts;
+}
+
+/**
+ * @brief Build each core's schedule table.
+ * @return Empty if every core's table was accepted, otherwise the first error.
+ */
+inline std::string build_tables(std::vector<Partition>& parts, const ExecConfig& cfg) {
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+        parts[i].table = build_schedule(parts[i].tasks, cfg);
+        if (!parts[i].table.ok()) {
+            return "core " + std::to_string(i) + ": " + parts[i].table.error;
+        }
+    }
+    return {};
+}
+
+struct CoreResult {
+    unsigned cpu = 0;
+    bool pinned = false;
+    FrameStats frames;
+    perf::Sample counters;  // this core's thread only
+};
+
+/**
+ * @brief Run one pinned executive per partition, all aligned to 't0'.
+ *        Core i is pinned to CPU i modulo the hardware thread count. With
+ *        Dispatch::Table call build_tables() first. An aperiodic server in
+ *        'cfg' is served by the least-loaded core only.
+ */
+template <typename C = Clock>
+inline std::vector<CoreResult> run_partitioned(const std::vector<Partition>& parts,
+                                               const ExecConfig& cfg, Clock::time_point t0) {
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<CoreResult> results(parts.size());
+    std::vector<std::thread> cores;
+    cores.reserve(parts.size());
+
+    // The server queue has a single consumer: the core with the most slack
+    const auto server_core = static_cast<std::size_t>(std::min_element(parts.begin(), parts.end(),
+        [](const Partition& a, const Partition& b) { return a.utilisation < b.utilisation; }) - parts.begin());
+
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+        cores.emplace_back([&, i] {
+            CoreResult& r = results[i];
+            r.cpu = static_cast<unsigned>(i % hw);
+            r.pinned = parallel::pin_current_thread(r.cpu);
+            const std::string label = "core " + std::to_string(i);
+            ExecConfig core_cfg = cfg;
+            if (i != server_core) {
+                core_cfg.server = nullptr;
+            }
+            perf::ScopedProfiler prof(label, perf::Scope::Thread);
+            switch (cfg.dispatch) {
+                case Dispatch::Table:
+                    r.frames = run_table_executive<C>(parts[i].tasks, parts[i].table, core_cfg, t0, label);
+                    break;
+                case Dispatch::Wheel:
+                    r.frames = run_wheel_executive<C>(parts[i].tasks, core_cfg, t0, label);
+                    break;
+                default:
+                    r.frames = run_executive<C>(parts[i].tasks, core_cfg, t0, label);
+                    break;
+            }
+            r.counters = prof.stop();
+        });
+    }
+    for (auto& th : cores) {
+        th.join();
+    }
+    return results;
+}
+
+} // namespace cyclic
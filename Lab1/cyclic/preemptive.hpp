@@ -0,0 +1,319 @@
+/**
+ * Preemptive EDF / rate-monotonic dispatcher, an alternative to the frame loop.
+ *
+ * A release thread wakes at each task's exact release instant and queues a
+ * job; a pool of worker threads runs the jobs. Which jobs may actually use a
+ * CPU is decided by priority:
+ *   EDF - earliest absolute deadline (release + period) first
+ *   RM  - shortest period first (fixed priority)
+ * At most 'cpus' jobs run at once; a lower-priority job parks at its next
+ * preemption_point() as soon as a higher-priority job is released, and
+ * resumes when it is again among the top 'cpus'. So a short SensorRead no
+ * longer waits behind a long job that happens to share its frame.
+ *
+ * If the process may use SCHED_FIFO, the release thread runs at the top
+ * priority and, under RM, each worker takes its job's priority, so the
+ * kernel preempts as well. Without permission everything stays at normal
+ * priority and preemption is purely cooperative (task bodies must reach a
+ * preemption point; busy_work_us does so on every iteration).
+ *
+ * A worker only takes a job off the ready queue once the job is among the
+ * top 'cpus', and each task has at most one job in flight: a release that
+ * finds the previous job still unfinished is skipped and counted as a
+ * deadline miss (it would have missed anyway, deadlines being implicit).
+ * So there is always a free worker for the next admitted job, even when the
+ * task set is overloaded.
+ *
+ * Deadlines are implicit (= period). Start latency, execution time (parked
+ * time excluded), response time and deadline misses are kept in RunStats;
+ * snapshots (ExecConfig::on_snapshot) are taken by the release thread.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "executive.hpp"
+
+namespace cyclic {
+
+enum class Policy { EDF, RM };
+
+struct DispatcherConfig {
+    Policy policy = Policy::EDF;
+    unsigned cpus = 1;          // jobs allowed to run at once
+    unsigned workers = 0;       // 0 = one per task plus one per CPU
+    bool realtime = true;       // try SCHED_FIFO first
+};
+
+struct DispatcherReport {
+    bool realtime = false;      // SCHED_FIFO was granted
+    std::uint64_t jobs = 0;
+    std::uint64_t preemptions = 0;  // times a running job parked for a higher-priority one
+    std::uint64_t skipped = 0;      // releases dropped because the task's previous job was unfinished
+};
+
+class PreemptiveDispatcher {
+    public:
+        PreemptiveDispatcher(const std::vector<Task*>& tasks, const ExecConfig& cfg, DispatcherConfig dcfg)
+            : tasks_(tasks), cfg_(cfg), dcfg_(dcfg), rm_rank_(tasks.size()), in_flight_(tasks.size(), 0) {
+            // Rate-monotonic rank: 0 = shortest period
+            std::vector<std::size_t> order(tasks_.size());
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+                return tasks_[a]->period < tasks_[b]->period;
+            });
+            for (std::size_t r = 0; r < order.size(); ++r) {
+                rm_rank_[order[r]] = r;
+            }
+        }
+
+        /**
+         * @brief Release jobs from 't0' until the configured number of major
+         *        cycles has elapsed, then wait for the pool to drain.
+         */
+        DispatcherReport run(Clock::time_point t0) {
+            report_ = {};
+            report_.realtime = dcfg_.realtime && set_fifo_priority(max_priority());
+
+            const unsigned workers = dcfg_.workers > 0 ? dcfg_.workers
+                : static_cast<unsigned>(tasks_.size()) + dcfg_.cpus;
+            std::vector<std::thread> pool;
+            for (unsigned w = 0; w < workers; ++w) {
+                pool.emplace_back(&PreemptiveDispatcher::worker_loop, this);
+            }
+
+            for (auto* t : tasks_) {
+                t->next_release = t0 + t->phase;
+            }
+            const auto end_time = t0 + cfg_.major_cycle * cfg_.major_cycles_to_run;
+            const auto snapshot_period = cfg_.major_cycle * std::max(cfg_.snapshot_every, 1);
+            auto next_snapshot = t0 + snapshot_period;
+
+            for (;;) {
+                // Next release across all tasks
+                std::size_t next = 0;
+                for (std::size_t i = 1; i < tasks_.size(); ++i) {
+                    if (tasks_[i]->next_release < tasks_[next]->next_release) {
+                        next = i;
+                    }
+                }
+                Task& t = *tasks_[next];
+                if (t.next_release >= end_time) {
+                    break;
+                }
+                std::this_thread::sleep_until(t.next_release);
+
+                if (cfg_.snapshot_every > 0 && cfg_.on_snapshot && t.next_release >= next_snapshot) {
+                    // Workers record stats under m_, so hold it while reading them
+                    std::lock_guard<std::mutex> lock(m_);
+                    cfg_.on_snapshot(tasks_, FrameStats{}, "");
+                    next_snapshot += snapshot_period;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(m_);
+                    if (in_flight_[next]) {
+                        // Previous job still running past its deadline: skip this release
+                        t.stats.deadline_misses++;
+                        report_.skipped++;
+                    } else {
+                        // Active from release, so a running lower-priority job sees it at
+                        // its next preemption point even before a worker picks it up
+                        const Key key = key_for(next, t.next_release);
+                        ready_.push({key, next, t.next_release});
+                        active_.insert(key);
+                        in_flight_[next] = 1;
+                        generation_.fetch_add(1, std::memory_order_release);
+                        report_.jobs++;
+                    }
+                }
+                // Admission depends on the whole active set, so any waiter may now qualify
+                work_cv_.notify_all();
+                t.next_release += t.period;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_);
+                stop_ = true;
+            }
+            // Drain: remaining jobs run without waiting for admission
+            work_cv_.notify_all();
+            gate_cv_.notify_all();
+            for (auto& th : pool) {
+                th.join();
+            }
+            if (report_.realtime) {
+                set_normal_priority();
+            }
+            return report_;
+        }
+
+    private:
+        // Smaller key = higher priority; seq breaks ties in release order
+        using Key = std::pair<long long, std::uint64_t>;
+
+        struct Job {
+            Key key;
+            std::size_t task;
+            Clock::time_point release;
+            bool operator>(const Job& o) const { return key > o.key; }
+        };
+
+        // Per-job state seen by the preemption hook
+        struct Running {
+            PreemptiveDispatcher* self;
+            Key key;
+            std::uint64_t seen_generation;
+            Clock::duration parked{0};
+        };
+
+        std::vector<Task*> tasks_;
+        ExecConfig cfg_;
+        DispatcherConfig dcfg_;
+        std::vector<std::size_t> rm_rank_;
+
+        std::mutex m_;
+        std::condition_variable work_cv_;   // workers waiting for a job
+        std::condition_variable gate_cv_;   // jobs waiting for a CPU
+        std::priority_queue<Job, std::vector<Job>, std::greater<>> ready_;
+        std::set<Key> active_;              // released and not yet finished
+        std::vector<char> in_flight_;       // per task: a job is released and not yet finished
+        std::atomic<std::uint64_t> generation_{0};   // bumped whenever active_ changes
+        std::uint64_t seq_ = 0;
+        bool stop_ = false;
+        DispatcherReport report_;
+
+        Key key_for(std::size_t task, Clock::time_point release) {
+            if (dcfg_.policy == Policy::RM) {
+                return {static_cast<long long>(rm_rank_[task]), seq_++};
+            }
+            const auto deadline = release + tasks_[task]->period;
+            return {deadline.time_since_epoch().count(), seq_++};
+        }
+
+        // Caller holds m_: is 'key' among the 'cpus' highest-priority active jobs?
+        bool admitted(const Key& key) const {
+            unsigned rank = 0;
+            for (auto it = active_.begin(); it != active_.end() && rank < dcfg_.cpus; ++it, ++rank) {
+                if (*it == key) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static Clock::duration preempt(void* ctx) {
+            auto& run = *static_cast<Running*>(ctx);
+            PreemptiveDispatcher& self = *run.self;
+            // Nothing was released or finished since we last looked: keep running
+            const std::uint64_t gen = self.generation_.load(std::memory_order_acquire);
+            if (gen == run.seen_generation) {
+                return Clock::duration::zero();
+            }
+
+            std::unique_lock<std::mutex> lock(self.m_);
+            run.seen_generation = self.generation_.load(std::memory_order_relaxed);
+            if (self.admitted(run.key)) {
+                return Clock::duration::zero();
+            }
+            self.report_.preemptions++;
+            const auto parked_at = Clock::now();
+            self.gate_cv_.wait(lock, [&] { return self.stop_ || self.admitted(run.key); });
+            const auto parked = Clock::now() - parked_at;
+            run.parked += parked;
+            run.seen_generation = self.generation_.load(std::memory_order_relaxed);
+            return parked;
+        }
+
+        void worker_loop() {
+            if (report_.realtime) {
+                // Below the release thread; under RM each job then sets its own level
+                set_fifo_priority(max_priority() - 1);
+            }
+            for (;;) {
+                // Take the best ready job only once it may run; while it may not,
+                // this worker stays free for whichever job is admitted next
+                std::unique_lock<std::mutex> lock(m_);
+                work_cv_.wait(lock, [this] {
+                    return stop_ || (!ready_.empty() && admitted(ready_.top().key));
+                });
+                if (ready_.empty()) {
+                    return; // stopping and drained
+                }
+                const Job job = ready_.top();
+                ready_.pop();
+
+                Running run{this, job.key, generation_.load(std::memory_order_relaxed)};
+                lock.unlock();
+
+                Task& t = *tasks_[job.task];
+                if (report_.realtime && dcfg_.policy == Policy::RM) {
+                    set_fifo_priority(max_priority() - 1 - static_cast<int>(rm_rank_[job.task]));
+                }
+
+                preemption_hook = {&PreemptiveDispatcher::preempt, &run};
+                const auto start = Clock::now();
+                t.work();
+                const auto finish = Clock::now();
+                preemption_hook = {};
+
+                lock.lock();
+                active_.erase(job.key);
+                in_flight_[job.task] = 0;
+                generation_.fetch_add(1, std::memory_order_release);
+                record_run(t, std::chrono::duration_cast<us>(start - job.release).count(),
+                           std::chrono::duration_cast<us>(finish - start - run.parked).count(),
+                           std::chrono::duration_cast<us>(finish - job.release).count());
+                lock.unlock();
+                gate_cv_.notify_all();
+                work_cv_.notify_all();
+            }
+        }
+
+        static int max_priority() {
+#if defined(__unix__) || defined(__APPLE__)
+            return sched_get_priority_max(SCHED_FIFO);
+#else
+            return 0;
+#endif
+        }
+
+        // SCHED_FIFO at 'priority' for the calling thread; false if not permitted
+        static bool set_fifo_priority(int priority) {
+#if defined(__unix__) || defined(__APPLE__)
+            sched_param param{};
+            param.sched_priority = std::max(priority, sched_get_priority_min(SCHED_FIFO));
+            return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+#else
+            (void)priority;
+            return false;
+#endif
+        }
+
+        static void set_normal_priority() {
+#if defined(__unix__) || defined(__APPLE__)
+            sched_param param{};
+            param.sched_priority = 0;
+            pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+#endif
+        }
+};
+
+} // namespace cyclic
@@ -0,0 +1,158 @@
+/**
+ * Precomputed hyperperiod schedule table for the cyclic executive.
+ *
+ * The release pattern of a periodic task set is fixed by its periods and
+ * phases, so instead of comparing every task against the clock every frame we
+ * work it out once before the executive starts:
+ *   - the hyperperiod H = lcm(periods), after which the pattern repeats;
+ *   - the frame checks: minor divides major, H divides major, and every
+ *     period / phase is a whole number of minor frames (so each release lands
+ *     on a frame boundary);
+ *   - a frame -> task-list table for one major cycle.
+ * A task set is rejected if the WCET budgets released in any frame add up to
+ * more than the minor cycle.
+ *
+ * At run time the executive just indexes the table with frame_idx, so the
+ * per-frame dispatch cost is O(tasks in that frame) and the same every cycle.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <initializer_list>
+#include <numeric> // For std::lcm
+#include <string>
+#include <vector>
+
+#include "executive.hpp"
+
+namespace cyclic {
+
+/**
+ * @brief Least common multiple of a range of periods (compile-time capable).
+ */
+template <typename Periods>
+constexpr ms hyperperiod(const Periods& periods) {
+    ms::rep h = 1;
+    for (const ms p : periods) {
+        h = std::lcm(h, p.count());
+    }
+    return ms{h};
+}
+
+/**
+ * @brief Check the minor / major / hyperperiod relationship.
+ * @return nullptr if consistent, otherwise the reason it is not.
+ */
+constexpr const char* check_frames(ms minor, ms major, ms hyper) {
+    if (minor.count() <= 0 || major.count() % minor.count() != 0) {
+        return "minor cycle does not divide the major cycle";
+    }
+    if (major.count() % hyper.count() != 0) {
+        return "hyperperiod does not divide the major cycle";
+    }
+    return nullptr;
+}
+
+static_assert(hyperperiod(std::initializer_list<ms>{ms{10}, ms{20}, ms{50}}) == ms{100});
+static_assert(check_frames(ms{10}, ms{100}, ms{100}) == nullptr);
+
+struct ScheduleTable {
+    ms hyperperiod{0};
+    std::vector<std::vector<std::size_t>> frames;  // frame -> indices into the task list
+    std::vector<long long> frame_load_us;           // summed WCET budget per frame
+    std::string error;                              // empty if the task set was accepted
+
+    bool ok() const { return error.empty(); }
+};
+
+/**
+ * @brief Build the frame table for one major cycle of 'tasks'.
+ *        Task indices refer to positions in 'tasks'.
+ */
+inline ScheduleTable build_schedule(const std::vector<Task*>& tasks, const ExecConfig& cfg) {
+    ScheduleTable table;
+    if (tasks.empty()) {
+        table.error = "empty task set";
+        return table;
+    }
+
+    std::vector<ms> periods;
+    for (const Task* t : tasks) {
+        if (t->period.count() <= 0 || t->period % cfg.minor_cycle != ms{0}) {
+            table.error = t->name + ": period is not a multiple of the minor cycle";
+            return table;
+        }
+        if (t->phase % cfg.minor_cycle != ms{0}) {
+            table.error = t->name + ": phase is not a multiple of the minor cycle";
+            return table;
+        }
+        periods.push_back(t->period);
+    }
+
+    table.hyperperiod = hyperperiod(periods);
+    if (const char* why = check_frames(cfg.minor_cycle, cfg.major_cycle, table.hyperperiod)) {
+        table.error = why;
+        return table;
+    }
+
+    const std::size_t num_frames = static_cast<std::size_t>(cfg.major_cycle / cfg.minor_cycle);
+    table.frames.assign(num_frames, {});
+    table.frame_load_us.assign(num_frames, 0);
+
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        const Task& t = *tasks[i];
+        const auto step = static_cast<std::size_t>(t.period / cfg.minor_cycle);
+        // The table repeats, so a phase just shifts the task's slot within its period
+        const auto first = static_cast<std::size_t>(t.phase / cfg.minor_cycle) % step;
+        for (std::size_t f = first; f < num_frames; f += step) {
+            table.frames[f].push_back(i);
+            table.frame_load_us[f] += t.wcet_budget.count();
+        }
+    }
+
+    const long long minor_us = std::chrono::duration_cast<us>(cfg.minor_cycle).count();
+    for (std::size_t f = 0; f < num_frames; ++f) {
+        if (table.frame_load_us[f] > minor_us) {
+            table.error = "frame " + std::to_string(f) + " needs " + std::to_string(table.frame_load_us[f])
+                        + " us of WCET but the minor cycle is " + std::to_string(minor_us) + " us";
+            return table;
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Table-driven executive: frame k runs exactly table.frames[k % frames].
+ *        Release jitter is measured against the frame boundary.
+ */
+template <typename C = Clock>
+inline FrameStats run_table_executive(const std::vector<Task*>& tasks, const ScheduleTable& table,
+                                      const ExecConfig& cfg, Clock::time_point t0,
+                                      const std::string& label = "") {
+    FrameStats fs = start_frames(cfg);
+    FrameWaiter waiter(cfg.wait);
+
+    waiter.wait_until<C>(t0, fs.wait);
+    auto frame_start = t0;
+    const auto end_time = t0 + cfg.major_cycle * cfg.major_cycles_to_run;
+    std::size_t frame_idx = 0;
+
+    // --- Main Executive Loop ---
+    while (C::now() < end_time) {
+        // 1) Execute this frame's precomputed task list
+        const auto now = C::now();
+        for (const std::size_t i : table.frames[frame_idx]) {
+            dispatch<C>(*tasks[i], frame_start, now);
+        }
+
+        // 2) Wait for the next frame boundary (sleep, or sleep then spin)
+        frame_idx = (frame_idx + 1) % table.frames.size();
+        frame_start += cfg.minor_cycle;
+        end_frame<C>(fs, waiter, tasks, frame_start, cfg, label);
+    }
+    return fs;
+}
+
+} // namespace cyclic
@@ -0,0 +1,174 @@
+/**
+ * Compile-time task sets for the cyclic executive.
+ *
+ * Each task is a StaticTask<period_ms, phase_ms, budget_us, F>: its timing is
+ * part of the type and its body is the concrete callable F (no std::function,
+ * no indirection). A StaticTaskSet<minor_ms, major_ms, Tasks...> keeps them
+ * in a std::tuple and builds the frame table at compile time, so
+ *   - the hyperperiod / frame checks of schedule_table.hpp are static_asserts,
+ *   - a task set whose frame budgets overflow the minor cycle does not compile,
+ *   - each frame is dispatched by a fold expression over the tuple, which the
+ *     compiler can inline body by body.
+ * Nothing is allocated at run time.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "executive.hpp"
+#include "schedule_table.hpp"
+
+namespace cyclic {
+
+template <long long PeriodMs, long long PhaseMs, long long BudgetUs, typename F>
+struct StaticTask {
+    static constexpr ms period{PeriodMs};
+    static constexpr ms phase{PhaseMs};
+    static constexpr us wcet_budget{BudgetUs};
+
+    const char* name;
+    F work;
+    RunStats stats{};
+};
+
+template <long long PeriodMs, long long PhaseMs, long long BudgetUs, typename F>
+StaticTask<PeriodMs, PhaseMs, BudgetUs, F> make_static_task(const char* name, F work) {
+    return {name, std::move(work)};
+}
+
+template <long long MinorMs, long long MajorMs, typename... Ts>
+class StaticTaskSet {
+    public:
+        static constexpr ms minor_cycle{MinorMs};
+        static constexpr ms major_cycle{MajorMs};
+        static constexpr std::size_t FRAMES = static_cast<std::size_t>(MajorMs / MinorMs);
+        static constexpr ms hyper = hyperperiod(std::array<ms, sizeof...(Ts)>{Ts::period...});
+
+        static_assert(sizeof...(Ts) > 0 && sizeof...(Ts) <= 64, "1..64 tasks per static set");
+        static_assert(((Ts::period.count() % MinorMs == 0) && ...),
+                      "every period must be a whole number of minor frames");
+        static_assert(((Ts::phase.count() % MinorMs == 0) && ...),
+                      "every phase must be a whole number of minor frames");
+        static_assert(check_frames(minor_cycle, major_cycle, hyper) == nullptr,
+                      "minor must divide major and the hyperperiod must divide major");
+
+        // Frame -> bitmask of tasks released in that frame, and its summed budget
+        static constexpr std::array<std::uint64_t, FRAMES> table = [] {
+            std::array<std::uint64_t, FRAMES> t{};
+            constexpr std::array<long long, sizeof...(Ts)> periods{(Ts::period.count() / MinorMs)...};
+            constexpr std::array<long long, sizeof...(Ts)> phases{(Ts::phase.count() / MinorMs)...};
+            for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+                for (auto f = static_cast<std::size_t>(phases[i] % periods[i]); f < FRAMES;
+                     f += static_cast<std::size_t>(periods[i])) {
+                    t[f] |= std::uint64_t{1} << i;
+                }
+            }
+            return t;
+        }();
+
+        static constexpr std::array<long long, FRAMES> frame_load_us = [] {
+            std::array<long long, FRAMES> load{};
+            constexpr std::array<long long, sizeof...(Ts)> budgets{Ts::wcet_budget.count()...};
+            for (std::size_t f = 0; f < FRAMES; ++f) {
+                for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+                    if (table[f] & (std::uint64_t{1} << i)) {
+                        load[f] += budgets[i];
+                    }
+                }
+            }
+            return load;
+        }();
+
+        static_assert([] {
+            for (const long long l : frame_load_us) {
+                if (l > MinorMs * 1000) {
+                    return false;
+                }
+            }
+            return true;
+        }(), "a frame's WCET budgets exceed the minor cycle");
+
+        explicit StaticTaskSet(Ts... tasks) : tasks_(std::move(tasks)...) {}
+
+        /**
+         * @brief Run the tasks of frame 'f' (in declaration order).
+         * @param release The frame boundary; @param now when the frame started.
+         */
+        template <typename C = Clock>
+        void run_frame(std::size_t f, Clock::time_point release, Clock::time_point now) {
+            run_frame_impl<C>(table[f], release, now, std::index_sequence_for<Ts...>{});
+        }
+
+        // Call fn(task) for each task, e.g. to print its stats
+        template <typename Fn>
+        void for_each(Fn&& fn) const {
+            std::apply([&fn](const auto&... t) { (fn(t), ...); }, tasks_);
+        }
+
+    private:
+        std::tuple<Ts...> tasks_;
+
+        template <typename C, std::size_t... I>
+        void run_frame_impl(std::uint64_t mask, Clock::time_point release, Clock::time_point now,
+                            std::index_sequence<I...>) {
+            ((mask & (std::uint64_t{1} << I) ? run_one<C, I>(release, now) : void()), ...);
+        }
+
+        template <typename C, std::size_t I>
+        void run_one(Clock::time_point release, Clock::time_point now) {
+            auto& t = std::get<I>(tasks_);
+            const auto exec_start = C::now();
+            t.work();
+            const auto exec_end = C::now();
+            record_run(t.stats, t.wcet_budget, t.period,
+                       std::chrono::duration_cast<us>(now - release).count(),
+                       std::chrono::duration_cast<us>(exec_end - exec_start).count(),
+                       std::chrono::duration_cast<us>(exec_end - release).count());
+        }
+};
+
+template <long long MinorMs, long long MajorMs, typename... Ts>
+StaticTaskSet<MinorMs, MajorMs, Ts...> make_static_task_set(Ts... tasks) {
+    return StaticTaskSet<MinorMs, MajorMs, Ts...>(std::move(tasks)...);
+}
+
+/**
+ * @brief Frame loop over a static task set. The set's minor/major cycle
+ *        override cfg's; everything else (run length, wait mode, slip
+ *        tolerance, snapshots of the frame stats) comes from cfg.
+ */
+template <typename C = Clock, typename Set>
+FrameStats run_static_executive(Set& set, ExecConfig cfg, Clock::time_point t0, const std::string& label = "") {
+    cfg.minor_cycle = Set::minor_cycle;
+    cfg.major_cycle = Set::major_cycle;
+    static const std::vector<Task*> no_runtime_tasks;
+
+    FrameStats fs = start_frames(cfg);
+    FrameWaiter waiter(cfg.wait);
+
+    waiter.wait_until<C>(t0, fs.wait);
+    auto frame_start = t0;
+    const auto end_time = t0 + cfg.major_cycle * cfg.major_cycles_to_run;
+    std::size_t frame_idx = 0;
+
+    // --- Main Executive Loop ---
+    while (C::now() < end_time) {
+        // 1) Execute this frame's tasks through the generated dispatch
+        set.template run_frame<C>(frame_idx, frame_start, C::now());
+
+        // 2) Wait for the next frame boundary (sleep, or sleep then spin)
+        frame_idx = (frame_idx + 1) % Set::FRAMES;
+        frame_start += cfg.minor_cycle;
+        end_frame<C>(fs, waiter, no_runtime_tasks, frame_start, cfg, label);
+    }
+    return fs;
+}
+
+} // namespace cyclic
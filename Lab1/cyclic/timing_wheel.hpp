@@ -0,0 +1,211 @@
+/**
+ * Hierarchical timing wheel release queue for large periodic task sets.
+ *
+ * Time is counted in integer ticks. The wheel has LEVELS levels of SLOTS
+ * slots; level l covers ticks in units of SLOTS^l, so four 64-slot levels
+ * reach 2^24 ticks ahead (about 4.6 hours at 1 ms per tick) and anything
+ * further out parks in the top level until it comes into range.
+ *
+ *   schedule(id, when, period)  O(1): append to the slot for 'when'
+ *   advance(to, fn)             per tick O(1) + O(entries due): expire the
+ *                               current level-0 slot, cascading a higher-level
+ *                               slot down whenever the lower level wraps
+ *
+ * Each slot is a contiguous array of 16-byte entries that carry everything a
+ * periodic release needs (id, due tick, period), so expiry and cascading
+ * stream through memory and never touch the tasks themselves. Entries due in
+ * the same tick come out in the order they were scheduled.
+ *
+ * An entry is moved down once per level it starts above, so its cost grows
+ * with log64(period / tick), not with the number of entries. In
+ * advanced-wheel-bench, where periods grow with the task count, that is the
+ * residual growth left at large task counts.
+ *
+ * run_wheel_executive() drives the cyclic executive from the wheel: each
+ * frame releases everything due up to "now" as one batch, and a task that
+ * slipped several periods is re-armed at its next period in one step
+ * instead of a catch-up loop.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "executive.hpp"
+
+namespace cyclic {
+
+class TimingWheel {
+    public:
+        using Id = std::uint32_t;
+        using Tick = std::uint64_t;
+
+        static constexpr unsigned LEVEL_BITS = 6;
+        static constexpr std::size_t SLOTS = std::size_t{1} << LEVEL_BITS;
+        static constexpr unsigned LEVELS = 4;
+
+        // Next tick to be expired
+        Tick now() const { return now_; }
+        std::size_t size() const { return size_; }
+
+        /**
+         * @brief Schedule 'id' to expire at tick 'when'. A 'when' that has
+         *        already passed expires with the next tick advanced over.
+         * @param period If non-zero, the entry re-arms itself 'period' ticks
+         *        after each expiry, skipping any periods advance() jumped past.
+         */
+        void schedule(Id id, Tick when, std::uint32_t period = 0) {
+            place({when, id, period});
+            size_++;
+        }
+
+        /**
+         * @brief Expire every tick up to and including 'to'.
+         * @param on_expire Called as on_expire(id, when) for each due entry;
+         *        it may schedule() (e.g. a one-shot follow-up). A periodic
+         *        entry expires at most once per call and is then re-armed at
+         *        its first release after 'to'.
+         * @return Number of entries expired.
+         */
+        template <typename F>
+        std::size_t advance(Tick to, F&& on_expire) {
+            std::size_t expired = 0;
+            while (now_ <= to) {
+                // Cascade: when level l-1 wraps, redistribute level l's current slot.
+                // Its entries always land in a lower level, never back in this slot.
+                for (unsigned l = 1; l < LEVELS; ++l) {
+                    if ((now_ & ((Tick{1} << (LEVEL_BITS * l)) - 1)) != 0) {
+                        break;
+                    }
+                    std::vector<Entry>& slot = slots_[l][slot_of(now_, l)];
+                    for (const Entry& e : slot) {
+                        place(e);
+                    }
+                    slot.clear();
+                }
+
+                // Indexed loop: on_expire may append to this very slot (a 'when'
+                // already passed), and those entries expire in this tick too
+                std::vector<Entry>& slot = slots_[0][slot_of(now_, 0)];
+                for (std::size_t i = 0; i < slot.size(); ++i) {
+                    Entry e = slot[i];
+                    expired++;
+                    on_expire(e.id, e.when);
+                    if (e.period == 0) {
+                        size_--;
+                        continue;
+                    }
+                    e.when += e.period;
+                    if (e.when <= to) {
+                        e.when += (to - e.when) / e.period * e.period + e.period;
+                    }
+                    place(e);
+                }
+                slot.clear();
+                ++now_;
+            }
+            return expired;
+        }
+
+    private:
+        // 16 bytes: the period fills what would otherwise be padding, so a
+        // periodic release touches nothing outside the slot arrays
+        struct Entry {
+            Tick when;
+            Id id;
+            std::uint32_t period;
+        };
+
+        // Each slot is a contiguous FIFO array: expiry and cascades stream
+        // through memory instead of chasing links, and clear() keeps the
+        // capacity, so nothing is allocated once every slot has seen its peak.
+        std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> slots_{};
+        Tick now_ = 0;
+        std::size_t size_ = 0;
+
+        static std::size_t slot_of(Tick t, unsigned level) {
+            return static_cast<std::size_t>((t >> (LEVEL_BITS * level)) & (SLOTS - 1));
+        }
+
+        // Append 'e' to the lowest level whose span still contains it
+        void place(Entry e) {
+            const Tick when = e.when < now_ ? now_ : e.when;
+            unsigned level = 0;
+            while (level < LEVELS && (when >> (LEVEL_BITS * (level + 1))) != (now_ >> (LEVEL_BITS * (level + 1)))) {
+                level++;
+            }
+            std::size_t slot;
+            if (level == LEVELS) {
+                // Beyond the horizon: park in the top-level slot cascaded last
+                level = LEVELS - 1;
+                slot = (slot_of(now_, level) + SLOTS - 1) & (SLOTS - 1);
+            } else {
+                slot = slot_of(when, level);
+            }
+            slots_[level][slot].push_back(e);
+        }
+};
+
+/**
+ * @brief Executive driven by a timing wheel with 'tick' resolution.
+ *        Each frame releases, as one batch, every task due by the start of
+ *        the frame; jitter is measured against each task's exact release.
+ */
+template <typename C = Clock>
+inline FrameStats run_wheel_executive(const std::vector<Task*>& tasks, const ExecConfig& cfg,
+                                      Clock::time_point t0, const std::string& label = "",
+                                      us tick = ms{1}) {
+    using Tick = TimingWheel::Tick;
+    const auto ticks_of = [tick](Clock::duration d) {
+        return static_cast<Tick>(d / tick);
+    };
+
+    // Release state lives in the wheel, so Task is only touched to run it
+    TimingWheel wheel;
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        const auto period = static_cast<std::uint32_t>(std::max<Tick>(1, ticks_of(tasks[i]->period)));
+        wheel.schedule(static_cast<TimingWheel::Id>(i), ticks_of(tasks[i]->phase), period);
+    }
+
+    struct Release {
+        TimingWheel::Id id;
+        Tick when;
+    };
+    std::vector<Release> batch;
+    batch.reserve(tasks.size());
+
+    FrameStats fs = start_frames(cfg);
+    FrameWaiter waiter(cfg.wait);
+
+    waiter.wait_until<C>(t0, fs.wait);
+    auto frame_start = t0;
+    const auto end_time = t0 + cfg.major_cycle * cfg.major_cycles_to_run;
+
+    // --- Main Executive Loop ---
+    while (C::now() < end_time) {
+        // 1) Collect everything due by now as one batch
+        const auto now = C::now();
+        const Tick now_tick = ticks_of(now - t0);
+        batch.clear();
+        const auto collect = [&batch](TimingWheel::Id id, Tick when) { batch.push_back({id, when}); };
+        wheel.advance(now_tick, collect);
+
+        // 2) Execute the batch. The wheel has already re-armed each task at
+        //    its next period, skipping straight past any periods we slipped.
+        for (const Release& r : batch) {
+            dispatch<C>(*tasks[r.id], t0 + tick * r.when, now);
+        }
+
+        // 3) Wait for the next frame boundary (sleep, or sleep then spin)
+        frame_start += cfg.minor_cycle;
+        end_frame<C>(fs, waiter, tasks, frame_start, cfg, label);
+    }
+    return fs;
+}
+
+} // namespace cyclic
@@ -0,0 +1,131 @@
+/**
+ * Measurement-based WCET estimation for task bodies.
+ *
+ * profile_wcet() calls a Task::work many times back to back, outside the
+ * executive, and times every run. Every cold_every-th run is preceded by a
+ * sweep over a buffer larger than the last-level cache, so that run starts
+ * with the task's data evicted ("cold"); the runs in between find it cached
+ * ("warm"). The two populations are kept in separate histograms.
+ *
+ * The estimate is statistical rather than just the largest observation: the
+ * run sequence is cut into blocks, a Gumbel distribution is fitted to the
+ * block maxima (method of moments), and the estimate is the execution time
+ * that distribution exceeds with probability 'exceedance' per run. It is
+ * never below the largest time actually observed. This is the usual
+ * extreme-value approach of measurement-based probabilistic timing analysis;
+ * it is only as good as the runs are representative (inputs, paths,
+ * interference), so leave headroom for what profiling cannot provoke.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "executive.hpp"
+#include "histogram.hpp"
+
+namespace cyclic {
+
+struct WcetConfig {
+    int runs = 2000;                        // timed runs per task
+    int cold_every = 10;                    // every n-th run starts cache-cold (0 = never)
+    std::size_t evict_bytes = 32u << 20;    // swept before a cold run; > LLC
+    int block = 50;                         // runs per block for the block maxima
+    double exceedance = 1e-9;               // per-run probability the estimate is exceeded
+};
+
+struct WcetProfile {
+    Histogram warm;
+    Histogram cold;
+    long long observed_us = 0;              // largest run seen
+    long long gumbel_us = 0;                // extreme-value quantile of the block maxima
+    us estimate{0};                         // max(observed, gumbel), a WCET budget candidate
+};
+
+// Keeps the eviction sweep from being optimised away
+inline volatile unsigned evict_sink = 0;
+
+/**
+ * @brief Touch one byte per cache line of 'buf' so the caches hold it
+ *        instead of whatever ran before.
+ */
+inline void evict_caches(std::vector<unsigned char>& buf) {
+    unsigned sum = 0;
+    for (std::size_t i = 0; i < buf.size(); i += 64) {
+        buf[i] = static_cast<unsigned char>(buf[i] + 1);
+        sum += buf[i];
+    }
+    evict_sink = sum;
+}
+
+/**
+ * @brief Gumbel quantile of 'maxima' for a per-run exceedance probability,
+ *        given 'block' runs per maximum. 0 if there are fewer than 2 maxima.
+ */
+inline long long gumbel_estimate(const std::vector<long long>& maxima, int block, double exceedance) {
+    if (maxima.size() < 2) {
+        return 0;
+    }
+    double mean = 0.0;
+    for (const long long m : maxima) {
+        mean += static_cast<double>(m);
+    }
+    mean /= static_cast<double>(maxima.size());
+    double var = 0.0;
+    for (const long long m : maxima) {
+        var += (static_cast<double>(m) - mean) * (static_cast<double>(m) - mean);
+    }
+    var /= static_cast<double>(maxima.size() - 1);
+
+    // Method of moments: scale from the spread, location from the mean
+    constexpr double PI = 3.14159265358979323846;
+    constexpr double EULER_GAMMA = 0.57721566490153286;
+    const double beta = std::sqrt(6.0 * var) / PI;
+    const double mu = mean - EULER_GAMMA * beta;
+
+    // A block exceeds x if any of its runs does
+    const double p_block = -std::expm1(static_cast<double>(block) * std::log1p(-exceedance));
+    const double x = mu - beta * std::log(-std::log1p(-p_block));
+    return static_cast<long long>(std::ceil(x));
+}
+
+/**
+ * @brief Time 'cfg.runs' calls of t.work with clock policy C. Leaves t.stats
+ *        alone; the caller decides whether to adopt the estimate as t.wcet_budget.
+ */
+template <typename C = Clock>
+WcetProfile profile_wcet(Task& t, const WcetConfig& cfg = {}) {
+    WcetProfile profile;
+    std::vector<unsigned char> evict(cfg.cold_every > 0 ? cfg.evict_bytes : 0);
+    std::vector<long long> maxima;
+    long long block_max = 0;
+
+    t.work(); // first call pays one-off costs (page faults, lazy init) outside the sample
+    for (int r = 0; r < cfg.runs; ++r) {
+        const bool cold = cfg.cold_every > 0 && r % cfg.cold_every == 0;
+        if (cold) {
+            evict_caches(evict);
+        }
+        const auto start = C::now();
+        t.work();
+        const long long exec = std::chrono::duration_cast<us>(C::now() - start).count();
+
+        (cold ? profile.cold : profile.warm).record(exec);
+        profile.observed_us = std::max(profile.observed_us, exec);
+        block_max = std::max(block_max, exec);
+        if ((r + 1) % cfg.block == 0) {
+            maxima.push_back(block_max);
+            block_max = 0;
+        }
+    }
+
+    profile.gumbel_us = gumbel_estimate(maxima, cfg.block, cfg.exceedance);
+    profile.estimate = us{std::max(profile.observed_us, profile.gumbel_us)};
+    return profile;
+}
+
+} // namespace cyclic
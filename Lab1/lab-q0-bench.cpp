@@ -0,0 +1,146 @@
+/**
+ * Thread-per-job vs work-stealing pool: latency and throughput.
+ *
+ * lab-q0 and Q1/step4 start a new std::thread for every unit of work. This
+ * compares that against parallel::WorkStealingPool (common/work_stealing_pool.hpp):
+ *   latency    - one job at a time: std::thread spawn + join vs pool submit + get,
+ *                reported as mean / p50 / p99 / max per job
+ *   throughput - 'jobs' jobs of 'work_us' busy work each: std::thread in batches
+ *                of 'threads' (spawn the batch, join the batch) vs submitting all
+ *                of them to a pool of 'threads' workers and getting every handle
+ * With empty or microsecond jobs the std::thread side is almost entirely
+ * thread creation and teardown; the pool pays one small allocation and a
+ * queue push per job.
+ *
+ * Usage: ./lab-q0-bench [iters] [jobs] [threads] [work_us]
+ * Compile: g++ -std=c++20 -O2 -pthread lab-q0-bench.cpp -o lab-q0-bench
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../common/work_stealing_pool.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+// Spin for 'us' microseconds (0 = return at once)
+void busy(int us) {
+    const auto until = Clock::now() + std::chrono::microseconds(us);
+    while (us > 0 && Clock::now() < until) {
+    }
+}
+
+void print_latency(const std::string& name, std::vector<double>& ns) {
+    std::sort(ns.begin(), ns.end());
+    double sum = 0.0;
+    for (const double v : ns) {
+        sum += v;
+    }
+    const auto at = [&ns](double pct) {
+        return ns[std::min(ns.size() - 1, static_cast<std::size_t>(pct / 100.0 * static_cast<double>(ns.size())))];
+    };
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1)
+              << " mean=" << std::setw(9) << sum / static_cast<double>(ns.size()) / 1000.0
+              << " p50=" << std::setw(9) << at(50) / 1000.0
+              << " p99=" << std::setw(9) << at(99) / 1000.0
+              << " max=" << std::setw(9) << ns.back() / 1000.0 << " us\n";
+}
+
+void print_throughput(const std::string& name, int jobs, Clock::duration elapsed) {
+    const double s = std::chrono::duration<double>(elapsed).count();
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(0)
+              << " " << std::setw(10) << jobs / s << " jobs/s  (" << std::setprecision(1)
+              << s * 1000.0 << " ms)\n";
+}
+
+void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [iters >= 1] [jobs >= 1] [threads >= 1] [work_us >= 0]\n";
+}
+
+/**
+ * @brief argv[i] as an int of at least 'min', 'fallback' if absent.
+ * @return false if the argument is not a whole number or is below 'min'.
+ */
+bool parse_arg(int argc, char* argv[], int i, int fallback, int min, int& out) {
+    out = fallback;
+    if (argc <= i) {
+        return true;
+    }
+    try {
+        std::size_t used = 0;
+        out = std::stoi(argv[i], &used);
+        return argv[i][used] == '\0' && out >= min;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int iters = 0;
+    int jobs = 0;
+    int num_threads = 0;
+    int work_us = 0;
+    const int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (!parse_arg(argc, argv, 1, 2000, 1, iters) || !parse_arg(argc, argv, 2, 20000, 1, jobs)
+        || !parse_arg(argc, argv, 3, hw, 1, num_threads) || !parse_arg(argc, argv, 4, 0, 0, work_us)) {
+        usage(argv[0]);
+        return 1;
+    }
+    const auto threads = static_cast<unsigned>(num_threads);
+
+    std::cout << "iters=" << iters << " jobs=" << jobs << " threads=" << threads
+              << " work=" << work_us << " us\n";
+
+    parallel::WorkStealingPool pool(threads);
+
+    // --- Latency: one job in flight at a time ---
+    std::cout << "\nLatency per job\n";
+    std::vector<double> ns(static_cast<std::size_t>(iters));
+    for (int i = 0; i < iters; ++i) {
+        const auto t0 = Clock::now();
+        std::thread t(busy, work_us);
+        t.join();
+        ns[static_cast<std::size_t>(i)] = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+    }
+    print_latency("std::thread+join", ns);
+
+    for (int i = 0; i < iters; ++i) {
+        const auto t0 = Clock::now();
+        pool.submit(busy, work_us).get();
+        ns[static_cast<std::size_t>(i)] = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+    }
+    print_latency("pool submit+get", ns);
+
+    // --- Throughput: many jobs, 'threads' of them in flight ---
+    std::cout << "\nThroughput\n";
+    auto t0 = Clock::now();
+    for (int done = 0; done < jobs;) {
+        std::vector<std::thread> batch;
+        for (unsigned k = 0; k < threads && done < jobs; ++k, ++done) {
+            batch.emplace_back(busy, work_us);
+        }
+        for (auto& t : batch) {
+            t.join();
+        }
+    }
+    print_throughput("std::thread batches", jobs, Clock::now() - t0);
+
+    t0 = Clock::now();
+    std::vector<parallel::TaskHandle<void>> handles;
+    handles.reserve(static_cast<std::size_t>(jobs));
+    for (int i = 0; i < jobs; ++i) {
+        handles.push_back(pool.submit(busy, work_us));
+    }
+    for (auto& h : handles) {
+        h.get();
+    }
+    print_throughput("pool submit+get", jobs, Clock::now() - t0);
+    std::cout << "steals=" << pool.steals() << "\n";
+    return 0;
+}
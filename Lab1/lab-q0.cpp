@@ -15,6 +15,8 @@
 #include <iostream>   // Used for console input/output (like cout)
 #include <thread>     // The main library for creating and managing threads
 
+#include "../common/work_stealing_pool.hpp"
+
 using namespace std;
 
 // This is the function that the thread will execute.
@@ -44,6 +46,15 @@ thread my_create_thread() {
     return t; 
 }
 
+// Follow-on: the same hand-over with a pooled job instead of a new thread.
+// The TaskHandle returned by submit() is move-only like std::thread, so it is
+// moved back to the caller exactly as 't' is above.
+parallel::TaskHandle<void> my_submit_task(parallel::WorkStealingPool& pool) {
+    parallel::TaskHandle<void> h = pool.submit(F_code);
+    cout << "my_submit_task: queued F_code on a pool of " << pool.size() << " workers" << endl;
+    return h;
+}
+
 int main () {
     // Create two uninitialized thread objects. They are not associated with any running thread yet.
     // Calling get_id() on them will show a default value indicating "not a thread".
@@ -67,6 +78,14 @@ int main () {
     // This is called "joining". If you don't join a thread, the program might terminate unexpectedly.
     t2.join();
     
+    // Follow-on: a pool worker runs F_code; ownership of the result moves h1 -> h2
+    parallel::WorkStealingPool pool(2);
+    parallel::TaskHandle<void> h1, h2;
+    h1 = my_submit_task(pool);
+    h2 = std::move(h1);
+    cout << "main: After move, h1 valid=" << h1.valid() << ", h2 valid=" << h2.valid() << endl;
+    h2.get(); // waits like t2.join()
+
     // This line will only be printed after the F_code function has completed.
     cout << "Main finished\n";
 
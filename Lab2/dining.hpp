@@ -0,0 +1,414 @@
+/**
+ * Dining philosophers simulation engine.
+ *
+ * Generalises lab2-2 to any number of philosophers and lets the chopstick
+ * acquisition strategy be chosen at runtime. Every philosopher is a thread
+ * that repeatedly thinks, waits for its two chopsticks and eats. The engine
+ * records, per philosopher, how many meals it had and how long each wait for
+ * chopsticks took, and summarises the run as:
+ *   - meals per second (whole table)
+ *   - p50 / p99 / max wait-for-chopsticks latency
+ *   - Jain's fairness index over meal counts (1.0 = perfectly even) and the
+ *     fewest meals any philosopher got (0 = someone starved)
+ *
+ * Strategies:
+ *   hierarchy    - resource hierarchy: lower-numbered chopstick first (the lab2-2 fix)
+ *   waiter       - arbitrator: a semaphore lets at most N-1 philosophers reach for chopsticks
+ *   chandy-misra - clean/dirty forks handed over on request (Chandy & Misra, 1984)
+ *   backoff      - try_lock both, release and back off exponentially on failure
+ *   scoped       - std::scoped_lock on both chopsticks (deadlock-avoiding std::lock)
+ *   atomic-mask  - chopsticks are bits in atomic words; both taken with one CAS,
+ *                  atomic::wait/notify when the CAS cannot succeed
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../common/multi_lock.hpp"
+
+namespace dining {
+
+using Clock = std::chrono::steady_clock;
+using us = std::chrono::microseconds;
+
+// Chopstick i sits between philosopher i (its right) and philosopher i+1 (its left)
+inline int left_of(int id, int /*n*/) { return id; }
+inline int right_of(int id, int n) { return (id + 1) % n; }
+
+/**
+ * @brief A chopstick acquisition strategy.
+ *
+ * dine() must call 'eat' exactly once while philosopher 'id' holds both of
+ * its chopsticks, and must have released them by the time it returns.
+ * Strategies that pick chopsticks up one at a time hold the first one for the
+ * pick pause before reaching for the second (lab2-2 waits 500 ms there).
+ */
+class Strategy {
+    public:
+        virtual ~Strategy() = default;
+        virtual const char* name() const = 0;
+        virtual void dine(int id, const std::function<void()>& eat) = 0;
+
+        void set_pick_pause(us pause) { pick_pause_ = pause; }
+
+    protected:
+        void pause_between_picks() const {
+            if (pick_pause_.count() > 0) {
+                std::this_thread::sleep_for(pick_pause_);
+            }
+        }
+
+    private:
+        us pick_pause_{0};
+};
+
+// Resource hierarchy: always take the lower-numbered chopstick first.
+class HierarchyStrategy : public Strategy {
+    public:
+        explicit HierarchyStrategy(int n) : n_(n), chopsticks_(new std::mutex[n]) {}
+
+        const char* name() const override { return "hierarchy"; }
+
+        void dine(int id, const std::function<void()>& eat) override {
+            const int a = left_of(id, n_);
+            const int b = right_of(id, n_);
+            std::lock_guard<std::mutex> first(chopsticks_[std::min(a, b)]);
+            pause_between_picks();
+            std::lock_guard<std::mutex> second(chopsticks_[std::max(a, b)]);
+            eat();
+        }
+
+    private:
+        int n_;
+        std::unique_ptr<std::mutex[]> chopsticks_;
+};
+
+// Waiter / arbitrator: only N-1 philosophers may hold or wait for chopsticks at
+// once, so at least one of them can always get both.
+class WaiterStrategy : public Strategy {
+    public:
+        explicit WaiterStrategy(int n)
+            : n_(n), chopsticks_(new std::mutex[n]), seats_(std::max(1, n - 1)) {}
+
+        const char* name() const override { return "waiter"; }
+
+        void dine(int id, const std::function<void()>& eat) override {
+            seats_.acquire();
+            {
+                std::lock_guard<std::mutex> left(chopsticks_[left_of(id, n_)]);
+                pause_between_picks();
+                std::lock_guard<std::mutex> right(chopsticks_[right_of(id, n_)]);
+                eat();
+            }
+            seats_.release();
+        }
+
+    private:
+        int n_;
+        std::unique_ptr<std::mutex[]> chopsticks_;
+        std::counting_semaphore<> seats_;
+};
+
+/**
+ * Chandy-Misra: every fork has an owner and is clean or dirty. Forks start
+ * dirty with the lower-numbered neighbour. A hungry philosopher may take a
+ * neighbour's fork if it is dirty and the neighbour is not eating (taking it
+ * cleans it); clean forks are kept until their owner has eaten. After eating
+ * both forks become dirty, so a neighbour that was waiting gets them next.
+ */
+class ChandyMisraStrategy : public Strategy {
+    public:
+        explicit ChandyMisraStrategy(int n) : n_(n), forks_(new Fork[n]), eating_(n, 0) {
+            for (int f = 0; f < n; ++f) {
+                // Fork f is shared by philosophers f and f-1: give it to the lower id
+                const int other = (f + n - 1) % n;
+                forks_[f].owner = std::min(f, other);
+            }
+        }
+
+        const char* name() const override { return "chandy-misra"; }
+
+        void dine(int id, const std::function<void()>& eat) override {
+            Fork& left = forks_[left_of(id, n_)];
+            Fork& right = forks_[right_of(id, n_)];
+            for (;;) {
+                obtain(left, id);
+                obtain(right, id);
+                // A dirty fork may have been taken back while we waited for the other one
+                std::scoped_lock both(left.m, right.m);
+                if (left.owner == id && right.owner == id) {
+                    eating_[id] = 1;
+                    break;
+                }
+            }
+            eat();
+            {
+                std::scoped_lock both(left.m, right.m);
+                eating_[id] = 0;
+                left.dirty = true;
+                right.dirty = true;
+            }
+            left.cv.notify_all();
+            right.cv.notify_all();
+        }
+
+    private:
+        struct Fork {
+            std::mutex m;
+            std::condition_variable cv;
+            int owner = 0;
+            bool dirty = true;
+        };
+
+        int n_;
+        std::unique_ptr<Fork[]> forks_;
+        // eating_[p] is written with both of p's fork mutexes held and read with one of them
+        std::vector<char> eating_;
+
+        void obtain(Fork& f, int id) {
+            std::unique_lock<std::mutex> lock(f.m);
+            while (f.owner != id) {
+                if (f.dirty && !eating_[f.owner]) {
+                    f.owner = id;
+                    f.dirty = false;
+                    break;
+                }
+                f.cv.wait(lock);
+            }
+        }
+};
+
+// try_lock both chopsticks; on failure drop everything and back off exponentially.
+class BackoffStrategy : public Strategy {
+    public:
+        explicit BackoffStrategy(int n) : n_(n), chopsticks_(new std::mutex[n]) {}
+
+        const char* name() const override { return "backoff"; }
+
+        void dine(int id, const std::function<void()>& eat) override {
+            std::mutex& left = chopsticks_[left_of(id, n_)];
+            std::mutex& right = chopsticks_[right_of(id, n_)];
+            thread_local std::minstd_rand jitter(std::random_device{}());
+            us backoff{1};
+
+            for (;;) {
+                if (left.try_lock()) {
+                    if (right.try_lock()) {
+                        break;
+                    }
+                    left.unlock();
+                }
+                // Randomised so neighbours do not retry in lock-step
+                std::this_thread::sleep_for(us(jitter() % (backoff.count() + 1)));
+                backoff = std::min(backoff * 2, MAX_BACKOFF);
+            }
+            eat();
+            right.unlock();
+            left.unlock();
+        }
+
+    private:
+        static constexpr us MAX_BACKOFF{1000};
+        int n_;
+        std::unique_ptr<std::mutex[]> chopsticks_;
+};
+
+// std::scoped_lock on both chopsticks at once.
+class ScopedLockStrategy : public Strategy {
+    public:
+        explicit ScopedLockStrategy(int n) : n_(n), chopsticks_(new std::mutex[n]) {}
+
+        const char* name() const override { return "scoped"; }
+
+        void dine(int id, const std::function<void()>& eat) override {
+            std::scoped_lock both(chopsticks_[left_of(id, n_)], chopsticks_[right_of(id, n_)]);
+            eat();
+        }
+
+    private:
+        int n_;
+        std::unique_ptr<std::mutex[]> chopsticks_;
+};
+
+// Both chopsticks in a single CAS on a shared bitmask (see multi_lock.hpp).
+// With more than 64 philosophers, the few whose chopsticks straddle two words
+// take them word by word in ascending order instead.
+// There is no queueing: a woken waiter competes with newcomers (barging), which
+// buys throughput at the cost of fairness - watch the jain / min meals columns.
+class AtomicMaskStrategy : public Strategy {
+    public:
+        explicit AtomicMaskStrategy(int n) : n_(n), chopsticks_(static_cast<std::size_t>(n)) {}
+
+        const char* name() const override { return "atomic-mask"; }
+
+        void dine(int id, const std::function<void()>& eat) override {
+            const auto left = static_cast<std::size_t>(left_of(id, n_));
+            const auto right = static_cast<std::size_t>(right_of(id, n_));
+            chopsticks_.acquire(left, right);
+            eat();
+            chopsticks_.release(left, right);
+        }
+
+    private:
+        int n_;
+        parallel::AtomicResourceSet chopsticks_;
+};
+
+inline const std::vector<std::string>& strategy_names() {
+    static const std::vector<std::string> names{"hierarchy", "waiter", "chandy-misra", "backoff", "scoped",
+                                                "atomic-mask"};
+    return names;
+}
+
+/**
+ * @brief Create a strategy by name for 'n' philosophers; nullptr if unknown.
+ */
+inline std::unique_ptr<Strategy> make_strategy(const std::string& name, int n) {
+    if (name == "hierarchy") return std::make_unique<HierarchyStrategy>(n);
+    if (name == "waiter") return std::make_unique<WaiterStrategy>(n);
+    if (name == "chandy-misra") return std::make_unique<ChandyMisraStrategy>(n);
+    if (name == "backoff") return std::make_unique<BackoffStrategy>(n);
+    if (name == "scoped") return std::make_unique<ScopedLockStrategy>(n);
+    if (name == "atomic-mask") return std::make_unique<AtomicMaskStrategy>(n);
+    return nullptr;
+}
+
+struct Config {
+    int philosophers = 5;
+    int meals = 0;                      // meals per philosopher; 0 = run for 'duration'
+    std::chrono::milliseconds duration{1000};
+    us think_min{50};
+    us think_max{150};
+    us eat{100};
+    us pick_pause{0};                   // hold time between first and second chopstick
+    std::uint32_t seed = 1;
+};
+
+struct Report {
+    std::string strategy;
+    int philosophers = 0;
+    double seconds = 0.0;
+    std::uint64_t meals = 0;
+    double meals_per_sec = 0.0;
+    double wait_p50_us = 0.0;
+    double wait_p99_us = 0.0;
+    double wait_max_us = 0.0;
+    double jain_fairness = 0.0;         // over per-philosopher meal counts
+    std::uint64_t min_meals = 0;
+};
+
+/**
+ * @brief Value at quantile q (0..1) of 'samples' (reordered in place).
+ */
+inline double percentile(std::vector<double>& samples, double q) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    const auto k = static_cast<std::size_t>(q * static_cast<double>(samples.size() - 1) + 0.5);
+    std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+    return samples[k];
+}
+
+/**
+ * @brief Jain's fairness index: (sum x)^2 / (n * sum x^2), 1.0 when all equal.
+ */
+inline double jain_index(const std::vector<std::uint64_t>& xs) {
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    for (auto x : xs) {
+        sum += static_cast<double>(x);
+        sum_sq += static_cast<double>(x) * static_cast<double>(x);
+    }
+    return sum_sq == 0.0 ? 1.0 : sum * sum / (static_cast<double>(xs.size()) * sum_sq);
+}
+
+/**
+ * @brief Build the summary from per-philosopher meal counts and wait samples.
+ */
+inline Report summarise(const std::string& strategy, double seconds,
+                        const std::vector<std::uint64_t>& meals,
+                        std::vector<double>& waits_us) {
+    Report r;
+    r.strategy = strategy;
+    r.philosophers = static_cast<int>(meals.size());
+    r.seconds = seconds;
+    for (auto m : meals) {
+        r.meals += m;
+    }
+    r.meals_per_sec = seconds > 0.0 ? static_cast<double>(r.meals) / seconds : 0.0;
+    r.wait_max_us = waits_us.empty() ? 0.0 : *std::max_element(waits_us.begin(), waits_us.end());
+    r.wait_p99_us = percentile(waits_us, 0.99);
+    r.wait_p50_us = percentile(waits_us, 0.50);
+    r.jain_fairness = jain_index(meals);
+    r.min_meals = meals.empty() ? 0 : *std::min_element(meals.begin(), meals.end());
+    return r;
+}
+
+/**
+ * @brief Run one simulation with real threads and real sleeps.
+ */
+inline Report run(Strategy& strategy, const Config& cfg) {
+    const int n = cfg.philosophers;
+    strategy.set_pick_pause(cfg.pick_pause);
+    std::vector<std::uint64_t> meals(n, 0);
+    std::vector<std::vector<double>> waits(n);
+    std::atomic<bool> stop{false};
+    std::latch go(n + 1);
+    std::vector<std::thread> threads;
+    threads.reserve(n);
+
+    for (int id = 0; id < n; ++id) {
+        threads.push_back(std::thread([&, id] {
+            std::minstd_rand rng(cfg.seed * 7919u + static_cast<std::uint32_t>(id));
+            std::uniform_int_distribution<long long> think(cfg.think_min.count(), cfg.think_max.count());
+            auto& my_waits = waits[id];
+            std::uint64_t my_meals = 0;
+            go.arrive_and_wait();
+
+            while (cfg.meals > 0 ? my_meals < static_cast<std::uint64_t>(cfg.meals)
+                                 : !stop.load(std::memory_order_relaxed)) {
+                std::this_thread::sleep_for(us(think(rng)));
+                const auto hungry = Clock::now();
+                strategy.dine(id, [&] {
+                    my_waits.push_back(std::chrono::duration<double, std::micro>(Clock::now() - hungry).count());
+                    std::this_thread::sleep_for(cfg.eat);
+                });
+                ++my_meals;
+            }
+            meals[id] = my_meals;
+        }));
+    }
+
+    const auto start = Clock::now();
+    go.arrive_and_wait();
+    if (cfg.meals == 0) {
+        std::this_thread::sleep_for(cfg.duration);
+        stop.store(true, std::memory_order_relaxed);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    std::vector<double> all_waits;
+    for (auto& w : waits) {
+        all_waits.insert(all_waits.end(), w.begin(), w.end());
+    }
+    return summarise(strategy.name(), elapsed.count(), meals, all_waits);
+}
+
+} // namespace dining
@@ -0,0 +1,411 @@
+/**
+ * Virtual-time discrete-event mode for the dining philosophers engine.
+ *
+ * Runs the same think / pick up / (pause) / pick up / eat / put down cycle as
+ * dining.hpp, but on one thread against a simulated clock: every sleep becomes
+ * a scheduled event and the clock jumps straight to the next event. Minutes of
+ * simulated time take milliseconds of wall time, so strategies and table sizes
+ * can be swept quickly.
+ *
+ * Locking semantics per strategy:
+ *   hierarchy    - two FIFO mutexes, lower-numbered first, pick pause in between
+ *   waiter       - FIFO semaphore with N-1 seats, then left, pause, right
+ *   chandy-misra - clean/dirty fork hand-over, same rules as ChandyMisraStrategy
+ *   backoff      - try both; on failure retry after a random exponential backoff
+ *   scoped       - all-or-nothing acquisition of both chopsticks
+ *   atomic-mask  - all-or-nothing acquisition of both chopsticks
+ *
+ * Events at the same instant fire in the order they were scheduled, so a run
+ * is fully deterministic for a given seed. Blocked philosophers are woken in
+ * FIFO order (std::mutex makes no fairness promise; FIFO is the simplest
+ * deterministic stand-in).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <ostream>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "dining.hpp"
+
+namespace dining {
+
+class VirtualTable {
+    public:
+        VirtualTable(const std::string& strategy, const Config& cfg, std::ostream* trace = nullptr)
+            : strategy_(strategy), cfg_(cfg), n_(cfg.philosophers), trace_(trace),
+              chopsticks_(n_), all_waiters_(n_), seats_(std::max(1, n_ - 1)),
+              fork_owner_(n_), fork_dirty_(n_, 1), eating_(n_, 0), phils_(n_) {
+            for (int f = 0; f < n_; ++f) {
+                fork_owner_[f] = std::min(f, (f + n_ - 1) % n_);
+            }
+            for (int id = 0; id < n_; ++id) {
+                Phil& p = phils_[id];
+                p.rng.seed(cfg.seed * 7919u + static_cast<std::uint32_t>(id));
+                p.program = program_for(id);
+                schedule(0, id); // everyone starts thinking at t = 0
+            }
+        }
+
+        bool valid() const { return !phils_.empty() && !phils_[0].program.empty(); }
+
+        /**
+         * @brief Process events until every philosopher has had its meals
+         *        (or until the simulated duration has elapsed).
+         */
+        Report run() {
+            const std::int64_t horizon = cfg_.meals > 0 ? INT64_MAX
+                : std::chrono::duration_cast<us>(cfg_.duration).count();
+
+            while (!events_.empty()) {
+                const Event e = events_.top();
+                if (e.t > horizon) {
+                    break;
+                }
+                events_.pop();
+                now_ = e.t;
+                advance(e.id);
+            }
+            const std::int64_t end = cfg_.meals > 0 ? now_ : horizon;
+
+            std::vector<std::uint64_t> meals(n_);
+            std::vector<double> waits;
+            for (int id = 0; id < n_; ++id) {
+                meals[id] = phils_[id].meals;
+                waits.insert(waits.end(), phils_[id].waits.begin(), phils_[id].waits.end());
+            }
+            return summarise(strategy_, static_cast<double>(end) / 1e6, meals, waits);
+        }
+
+        // Number of events processed so far
+        std::uint64_t events() const { return seq_; }
+
+    private:
+        enum class Op { Think, Lock, Pause, LockBoth, TryBoth, Seat, ChandyMisra, Eat, PutDown, Done };
+
+        struct Step {
+            Op op;
+            int res = -1;
+        };
+
+        struct Event {
+            std::int64_t t;
+            std::uint64_t seq;
+            int id;
+            bool operator>(const Event& o) const { return t != o.t ? t > o.t : seq > o.seq; }
+        };
+
+        struct Phil {
+            std::vector<Step> program;
+            std::size_t pc = 0;
+            bool blocked = false;
+            bool has_seat = false;
+            std::vector<int> held;
+            std::int64_t hungry_since = 0;
+            std::uint64_t meals = 0;
+            std::vector<double> waits;
+            std::minstd_rand rng;
+            std::int64_t backoff = 1;
+        };
+
+        struct Mutex {
+            int owner = -1;
+            std::deque<int> queue;
+        };
+
+        static constexpr std::int64_t MAX_BACKOFF_US = 1000;
+
+        std::string strategy_;
+        Config cfg_;
+        int n_;
+        std::ostream* trace_;
+        std::int64_t now_ = 0;
+        std::uint64_t seq_ = 0;
+        std::priority_queue<Event, std::vector<Event>, std::greater<>> events_;
+
+        std::vector<Mutex> chopsticks_;
+        std::vector<std::deque<int>> all_waiters_;   // LockBoth waiters per chopstick
+        int seats_;
+        std::deque<int> seat_queue_;
+        std::vector<int> fork_owner_;                // Chandy-Misra
+        std::vector<char> fork_dirty_;
+        std::vector<char> eating_;
+        std::vector<Phil> phils_;
+
+        std::vector<Step> program_for(int id) const {
+            const int l = left_of(id, n_);
+            const int r = right_of(id, n_);
+            if (strategy_ == "hierarchy") {
+                return {{Op::Think}, {Op::Lock, std::min(l, r)}, {Op::Pause}, {Op::Lock, std::max(l, r)},
+                        {Op::Eat}, {Op::PutDown}};
+            }
+            if (strategy_ == "waiter") {
+                return {{Op::Think}, {Op::Seat}, {Op::Lock, l}, {Op::Pause}, {Op::Lock, r},
+                        {Op::Eat}, {Op::PutDown}};
+            }
+            if (strategy_ == "chandy-misra") {
+                return {{Op::Think}, {Op::ChandyMisra}, {Op::Eat}, {Op::PutDown}};
+            }
+            if (strategy_ == "backoff") {
+                return {{Op::Think}, {Op::TryBoth}, {Op::Eat}, {Op::PutDown}};
+            }
+            if (strategy_ == "scoped" || strategy_ == "atomic-mask") {
+                return {{Op::Think}, {Op::LockBoth}, {Op::Eat}, {Op::PutDown}};
+            }
+            return {};
+        }
+
+        void schedule(std::int64_t delay, int id) {
+            events_.push({now_ + delay, seq_++, id});
+        }
+
+        // Unblock 'id'; it resumes at the current instant, after already-queued events
+        void wake(int id) {
+            phils_[id].blocked = false;
+            schedule(0, id);
+        }
+
+        void say(int id, const std::string& what) {
+            if (trace_ != nullptr) {
+                *trace_ << "[t=" << now_ / 1000.0 << " ms] Philosopher " << id << ' ' << what << '\n';
+            }
+        }
+
+        bool both_free(int id) const {
+            return chopsticks_[left_of(id, n_)].owner < 0 && chopsticks_[right_of(id, n_)].owner < 0;
+        }
+
+        void take_both(int id) {
+            for (int c : {left_of(id, n_), right_of(id, n_)}) {
+                chopsticks_[c].owner = id;
+                phils_[id].held.push_back(c);
+            }
+        }
+
+        // Run philosopher 'id' from its current step until it blocks or sleeps
+        void advance(int id) {
+            Phil& p = phils_[id];
+            if (p.blocked) {
+                return;
+            }
+            for (;;) {
+                const Step step = p.program[p.pc];
+                switch (step.op) {
+                    case Op::Think:
+                        if (cfg_.meals > 0 && p.meals >= static_cast<std::uint64_t>(cfg_.meals)) {
+                            say(id, "is FINISHED and leaving.");
+                            p.program = {{Op::Done}};
+                            p.pc = 0;
+                            return;
+                        }
+                        say(id, "is thinking.");
+                        p.pc++;
+                        {
+                            std::uniform_int_distribution<long long> think(cfg_.think_min.count(),
+                                                                          cfg_.think_max.count());
+                            p.hungry_since = -1;
+                            schedule(think(p.rng), id);
+                        }
+                        return;
+
+                    case Op::Lock: {
+                        mark_hungry(p);
+                        Mutex& m = chopsticks_[step.res];
+                        if (m.owner == id) {
+                            // Granted while we were blocked
+                            p.pc++;
+                            break;
+                        }
+                        say(id, "tries to pick up chopstick ID " + std::to_string(step.res));
+                        if (m.owner < 0) {
+                            m.owner = id;
+                            p.held.push_back(step.res);
+                            say(id, "GOT chopstick ID " + std::to_string(step.res));
+                            p.pc++;
+                            break;
+                        }
+                        m.queue.push_back(id);
+                        p.blocked = true;
+                        return;
+                    }
+
+                    case Op::Pause:
+                        p.pc++;
+                        if (cfg_.pick_pause.count() > 0) {
+                            schedule(cfg_.pick_pause.count(), id);
+                            return;
+                        }
+                        break;
+
+                    case Op::LockBoth:
+                        mark_hungry(p);
+                        if (p.held.size() == 2) {
+                            p.pc++;
+                            break;
+                        }
+                        if (both_free(id)) {
+                            take_both(id);
+                            p.pc++;
+                            break;
+                        }
+                        all_waiters_[left_of(id, n_)].push_back(id);
+                        all_waiters_[right_of(id, n_)].push_back(id);
+                        p.blocked = true;
+                        return;
+
+                    case Op::TryBoth:
+                        mark_hungry(p);
+                        if (both_free(id)) {
+                            take_both(id);
+                            p.backoff = 1;
+                            p.pc++;
+                            break;
+                        }
+                        schedule(static_cast<std::int64_t>(p.rng() % (p.backoff + 1)), id);
+                        p.backoff = std::min(p.backoff * 2, MAX_BACKOFF_US);
+                        return;
+
+                    case Op::Seat:
+                        mark_hungry(p);
+                        if (!p.has_seat) {
+                            if (seats_ == 0) {
+                                seat_queue_.push_back(id);
+                                p.blocked = true;
+                                return;
+                            }
+                            seats_--;
+                            p.has_seat = true;
+                        }
+                        p.pc++;
+                        break;
+
+                    case Op::ChandyMisra: {
+                        mark_hungry(p);
+                        for (int f : {left_of(id, n_), right_of(id, n_)}) {
+                            const int owner = fork_owner_[f];
+                            if (owner != id && fork_dirty_[f] && !eating_[owner]) {
+                                fork_owner_[f] = id;
+                                fork_dirty_[f] = 0;
+                            }
+                        }
+                        if (fork_owner_[left_of(id, n_)] == id && fork_owner_[right_of(id, n_)] == id) {
+                            eating_[id] = 1;
+                            p.pc++;
+                            break;
+                        }
+                        p.blocked = true;
+                        return;
+                    }
+
+                    case Op::Eat:
+                        p.waits.push_back(static_cast<double>(now_ - p.hungry_since));
+                        say(id, "is EATING.");
+                        p.pc++;
+                        schedule(cfg_.eat.count(), id);
+                        return;
+
+                    case Op::PutDown:
+                        say(id, "is putting down chopsticks.");
+                        p.meals++;
+                        put_down(id);
+                        p.pc = 0;
+                        break;
+
+                    case Op::Done:
+                        return;
+                }
+            }
+        }
+
+        void mark_hungry(Phil& p) {
+            if (p.hungry_since < 0) {
+                p.hungry_since = now_;
+            }
+        }
+
+        void put_down(int id) {
+            Phil& p = phils_[id];
+            if (strategy_ == "chandy-misra") {
+                eating_[id] = 0;
+                for (int f : {left_of(id, n_), right_of(id, n_)}) {
+                    fork_dirty_[f] = 1;
+                }
+                for (int q : {(id + n_ - 1) % n_, (id + 1) % n_}) {
+                    if (phils_[q].blocked) {
+                        wake(q);
+                    }
+                }
+                return;
+            }
+
+            const std::vector<int> held = std::move(p.held);
+            p.held.clear();
+            for (int c : held) {
+                chopsticks_[c].owner = -1;
+            }
+            for (int c : held) {
+                Mutex& m = chopsticks_[c];
+                if (m.owner < 0 && !m.queue.empty()) {
+                    const int q = m.queue.front();
+                    m.queue.pop_front();
+                    m.owner = q;
+                    phils_[q].held.push_back(c);
+                    say(q, "GOT chopstick ID " + std::to_string(c));
+                    wake(q);
+                }
+                grant_both_waiters(c);
+            }
+            if (p.has_seat) {
+                p.has_seat = false;
+                if (!seat_queue_.empty()) {
+                    const int q = seat_queue_.front();
+                    seat_queue_.pop_front();
+                    phils_[q].has_seat = true;
+                    wake(q);
+                } else {
+                    seats_++;
+                }
+            }
+        }
+
+        // FIFO scan of the all-or-nothing waiters of chopstick 'c'
+        void grant_both_waiters(int c) {
+            auto& waiters = all_waiters_[c];
+            for (auto it = waiters.begin(); it != waiters.end();) {
+                const int q = *it;
+                if (!both_free(q)) {
+                    ++it;
+                    continue;
+                }
+                take_both(q);
+                it = waiters.erase(it);
+                // Also drop q from the queue of its other chopstick
+                const int other = left_of(q, n_) == c ? right_of(q, n_) : left_of(q, n_);
+                auto& other_list = all_waiters_[other];
+                other_list.erase(std::find(other_list.begin(), other_list.end(), q));
+                wake(q);
+            }
+        }
+};
+
+/**
+ * @brief Run one simulation in virtual time. Report times are simulated.
+ * @throws std::invalid_argument for an unknown strategy or no philosophers.
+ */
+inline Report run_virtual(const std::string& strategy, const Config& cfg, std::ostream* trace = nullptr) {
+    VirtualTable table(strategy, cfg, trace);
+    if (!table.valid()) {
+        throw std::invalid_argument("run_virtual: unknown strategy '" + strategy + "' or no philosophers");
+    }
+    return table.run();
+}
+
+} // namespace dining
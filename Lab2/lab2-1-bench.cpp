@@ -0,0 +1,290 @@
+/**
+ * Thread-scaling benchmark for the lab2-1 summation workload.
+ *
+ * Sums 'iters' random draws in [0, 100] split across N threads and compares
+ * four ways of getting the random numbers:
+ *   shared-racy   - one global std::mt19937 used by every thread (data race, as in lab2-1)
+ *   mutex         - one global std::mt19937 guarded by a std::mutex per draw
+ *   thread-local  - each thread owns an mt19937 seeded from seed_seq{seed, thread}
+ *   counter       - each thread owns a Philox engine positioned at its chunk (rng_streams.hpp)
+ *
+ * Threads are created before the clock starts and released together, so thread
+ * creation is not timed. Each configuration runs warm-up trials followed by timed
+ * trials; mean, standard deviation, throughput, speedup and parallel efficiency
+ * (both relative to the same variant on 1 thread) are printed as CSV or JSON.
+ *
+ * Usage: ./lab2-1-bench [--threads 1,2,4] [--iters 1000000,10000000]
+ *                       [--trials 5] [--warmup 1] [--format csv|json]
+ * Compile: g++ -std=c++20 -O2 -pthread lab2-1-bench.cpp -o lab2-1-bench
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>       // For std::ref
+#include <latch>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include "rng_streams.hpp"
+
+const std::uint32_t SEED = 12345;
+const std::uint32_t DRAW_RANGE = 101; // values 0..100
+
+enum class Variant { SharedRacy, Mutex, ThreadLocal, Counter };
+
+const char* variant_name(Variant v) {
+    switch (v) {
+        case Variant::SharedRacy:  return "shared-racy";
+        case Variant::Mutex:       return "mutex";
+        case Variant::ThreadLocal: return "thread-local";
+        case Variant::Counter:     return "counter";
+    }
+    return "?";
+}
+
+// Shared state for the first two variants (reset before every trial)
+std::mt19937 shared_gen(SEED);
+std::mutex shared_mutex;
+
+struct Trial {
+    double seconds;
+    long long sum;
+};
+
+/**
+ * @brief Body of one benchmark thread: sum 'count' draws starting at draw 'first'.
+ */
+void bench_worker(Variant variant, unsigned thread_idx, std::uint64_t first, std::uint64_t count,
+                  std::latch& go, std::atomic<long long>& totalSum) {
+    long long localSum = 0;
+
+    switch (variant) {
+        case Variant::SharedRacy:
+            go.arrive_and_wait();
+            for (std::uint64_t i = 0; i < count; ++i) {
+                localSum += rng_streams::bounded(shared_gen(), DRAW_RANGE); // !!! DATA RACE !!!
+            }
+            break;
+        case Variant::Mutex:
+            go.arrive_and_wait();
+            for (std::uint64_t i = 0; i < count; ++i) {
+                std::lock_guard<std::mutex> lock(shared_mutex);
+                localSum += rng_streams::bounded(shared_gen(), DRAW_RANGE);
+            }
+            break;
+        case Variant::ThreadLocal: {
+            go.arrive_and_wait();
+            std::seed_seq seq{SEED, static_cast<std::uint32_t>(thread_idx)};
+            std::mt19937 engine(seq);
+            for (std::uint64_t i = 0; i < count; ++i) {
+                localSum += rng_streams::bounded(engine(), DRAW_RANGE);
+            }
+            break;
+        }
+        case Variant::Counter: {
+            go.arrive_and_wait();
+            auto engine = rng_streams::make_philox_stream(SEED, first);
+            for (std::uint64_t i = 0; i < count; ++i) {
+                localSum += rng_streams::bounded(engine(), DRAW_RANGE);
+            }
+            break;
+        }
+    }
+
+    totalSum.fetch_add(localSum, std::memory_order_relaxed);
+}
+
+Trial run_trial(Variant variant, unsigned num_threads, std::uint64_t iters) {
+    shared_gen.seed(SEED);
+    std::atomic<long long> totalSum(0);
+    std::latch go(num_threads + 1);
+    std::vector<std::thread> threads;
+
+    for (unsigned i = 0; i < num_threads; ++i) {
+        const auto first = rng_streams::chunk_begin(iters, num_threads, i);
+        const auto count = rng_streams::chunk_begin(iters, num_threads, i + 1) - first;
+        threads.push_back(std::thread(bench_worker, variant, i, first, count,
+                                      std::ref(go), std::ref(totalSum)));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go.arrive_and_wait();
+    for (auto& t : threads) {
+        t.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    const std::chrono::duration<double> diff = end - start;
+    return {diff.count(), totalSum.load()};
+}
+
+struct Measurement {
+    double mean_s;
+    double stddev_s;
+    std::vector<long long> sums;
+};
+
+/**
+ * @brief Warm-up runs followed by 'trials' timed runs of one configuration.
+ */
+Measurement measure(Variant variant, unsigned num_threads, std::uint64_t iters, int warmup, int trials) {
+    for (int w = 0; w < warmup; ++w) {
+        run_trial(variant, num_threads, iters);
+    }
+
+    Measurement m{0.0, 0.0, {}};
+    double sum_sq = 0.0;
+    for (int t = 0; t < trials; ++t) {
+        const Trial trial = run_trial(variant, num_threads, iters);
+        m.mean_s += trial.seconds;
+        sum_sq += trial.seconds * trial.seconds;
+        m.sums.push_back(trial.sum);
+    }
+    m.mean_s /= trials;
+    m.stddev_s = std::sqrt(std::max(0.0, sum_sq / trials - m.mean_s * m.mean_s));
+    return m;
+}
+
+struct Result {
+    Variant variant;
+    unsigned threads;
+    std::uint64_t iters;
+    double mean_s;
+    double stddev_s;
+    double throughput;      // draws per second
+    double speedup;         // vs the same variant on 1 thread
+    double efficiency;      // speedup / threads
+    bool reproducible;      // every trial gave the 1-thread sum
+};
+
+// Comma-separated list of positive counts; empty if any entry is below 1
+std::vector<std::uint64_t> parse_list(const std::string& arg) {
+    std::vector<std::uint64_t> values;
+    std::stringstream ss(arg);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        const long long value = std::stoll(item);
+        if (value < 1) {
+            return {};
+        }
+        values.push_back(static_cast<std::uint64_t>(value));
+    }
+    return values;
+}
+
+void print_csv(const std::vector<Result>& results) {
+    std::cout << "variant,threads,iters,mean_s,stddev_s,throughput_per_s,speedup,efficiency,reproducible\n";
+    for (const auto& r : results) {
+        std::cout << variant_name(r.variant) << ',' << r.threads << ',' << r.iters << ','
+                  << std::setprecision(6) << r.mean_s << ',' << r.stddev_s << ','
+                  << std::setprecision(10) << r.throughput << ','
+                  << std::setprecision(4) << r.speedup << ',' << r.efficiency << ','
+                  << (r.reproducible ? "true" : "false") << '\n';
+    }
+}
+
+void print_json(const std::vector<Result>& results) {
+    std::cout << "[\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        std::cout << "  {\"variant\": \"" << variant_name(r.variant) << "\""
+                  << ", \"threads\": " << r.threads
+                  << ", \"iters\": " << r.iters
+                  << std::setprecision(6) << ", \"mean_s\": " << r.mean_s
+                  << ", \"stddev_s\": " << r.stddev_s
+                  << std::setprecision(10) << ", \"throughput_per_s\": " << r.throughput
+                  << std::setprecision(4) << ", \"speedup\": " << r.speedup
+                  << ", \"efficiency\": " << r.efficiency
+                  << ", \"reproducible\": " << (r.reproducible ? "true" : "false") << "}"
+                  << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    std::cout << "]\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::uint64_t> thread_counts;
+    std::vector<std::uint64_t> iter_counts{1000000};
+    int trials = 5;
+    int warmup = 1;
+    std::string format = "csv";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        const std::string value = argv[i + 1];
+        if (flag == "--threads") {
+            thread_counts = parse_list(value);
+            if (thread_counts.empty()) {
+                std::cerr << "thread counts must be >= 1\n";
+                return 1;
+            }
+        } else if (flag == "--iters") {
+            iter_counts = parse_list(value);
+            if (iter_counts.empty()) {
+                std::cerr << "iteration counts must be >= 1\n";
+                return 1;
+            }
+        } else if (flag == "--trials") {
+            trials = std::stoi(value);
+        } else if (flag == "--warmup") {
+            warmup = std::stoi(value);
+        } else if (flag == "--format") {
+            format = value;
+        } else {
+            std::cerr << "Unknown option " << flag << "\n";
+            return 1;
+        }
+    }
+    if (argc % 2 == 0 || trials < 1 || warmup < 0 || (format != "csv" && format != "json")) {
+        std::cerr << "Usage: " << argv[0] << " [--threads 1,2,4] [--iters 1000000]"
+                  << " [--trials 5] [--warmup 1] [--format csv|json]\n";
+        return 1;
+    }
+    if (thread_counts.empty()) {
+        // Powers of two up to the core count, plus the core count itself
+        const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned n = 1; n < hw; n *= 2) {
+            thread_counts.push_back(n);
+        }
+        thread_counts.push_back(hw);
+    }
+
+    const Variant variants[] = {Variant::SharedRacy, Variant::Mutex, Variant::ThreadLocal, Variant::Counter};
+    std::vector<Result> results;
+
+    for (std::uint64_t iters : iter_counts) {
+        for (Variant variant : variants) {
+            // 1-thread baseline for speedup and for the reproducibility check
+            const Measurement single = measure(variant, 1, iters, warmup, trials);
+
+            for (std::uint64_t n : thread_counts) {
+                const auto threads = static_cast<unsigned>(n);
+                const Measurement m = threads == 1 ? single : measure(variant, threads, iters, warmup, trials);
+
+                bool reproducible = true;
+                for (long long sum : m.sums) {
+                    reproducible = reproducible && sum == single.sums.front();
+                }
+                const double speedup = single.mean_s / m.mean_s;
+                results.push_back({variant, threads, iters, m.mean_s, m.stddev_s,
+                                   static_cast<double>(iters) / m.mean_s, speedup,
+                                   speedup / threads, reproducible});
+            }
+        }
+    }
+
+    if (format == "json") {
+        print_json(results);
+    } else {
+        print_csv(results);
+    }
+    return 0;
+}
@@ -2,22 +2,46 @@
  * Demonstrate that the std::mt19937 is not thread-safe by running the pgoramme multiple times. If it were thread-safe, the programme would wlays produce the same result because the random number generator's seed is fixed.
  * Add Timing code to find out how long the program takes to run.
  * Once you've done that, look at the follow-on tasks below:
+ *
+ * Follow-on: reproducible parallel streams.
+ * Usage: ./lab2-1 [shared|discard|philox] [num_threads]
+ *   shared  - original racy version (all threads hammer the global 'gen')
+ *   discard - each thread owns an mt19937 and discard()s up to its chunk of the
+ *             stream. Reproducibility reference only: the skip is O(offset), so
+ *             the last thread steps through almost the whole stream first and
+ *             this does not scale with threads
+ *   philox  - each thread owns a counter-based Philox engine positioned at its
+ *             chunk in O(1); the mode that scales
+ * In 'discard' and 'philox' mode the N-thread sum is checked against a 1-thread
+ * run of the same stream and must match exactly.
  */
 
 #include <iostream>
 #include <random>
 #include <thread>
 #include <vector>
-#include <atomic>
-#include <chrono>           // For timing
-#include <functional>       // For std::ref
+#include <functional>       // For std::plus
+#include <string>
+#include <cstdint>
+
+#include "rng_streams.hpp"
+#include "../common/parallel_reduce.hpp"
+#include "../common/perf_counters.hpp"
+
+const std::uint32_t SEED = 12345;
+const int TOTAL_ITERS = 1000000;
+const std::uint32_t DRAW_RANGE = 101; // values 0..100
 
 // Global engine (seeded for consistent single-thread runs)
-std::mt19937 gen(12345); 
+std::mt19937 gen(SEED);
 
 // Global distribution (matches your 'correct sum' of 50460531)
 // This is also not thread-safe!
-std::uniform_int_distribution<> dist(0, 100); 
+// NOTE: the distribution algorithm is implementation-defined, so the single-thread
+// sum depends on the standard library (libstdc++ and libc++ disagree).
+std::uniform_int_distribution<> dist(0, 100);
+
+enum class Mode { Shared, Discard, Philox };
 
 /**
  * @brief Worker function to generate random numbers and sum them.
@@ -25,9 +49,9 @@ std::uniform_int_distribution<> dist(0, 100);
  * It accesses the global 'gen' and 'dist' variables concurrently
  * from multiple threads without any locks.
  */
-void worker (std::atomic<long long>& totalSum, int iterations) {
+void worker (long long& partialSum, int iterations) {
     long long localSum = 0;
-    
+
     for (int i = 0; i < iterations; ++i) {
         // !!! DATA RACE !!!
         // Unsafe concurrent access to shared 'dist' and 'gen'.
@@ -36,44 +60,108 @@ void worker (std::atomic<long long>& totalSum, int iterations) {
         localSum += dist(gen);
     }
 
-    // Safe accumulation using atomic addition
-    totalSum.fetch_add(localSum, std::memory_order_relaxed);
+    // Written once, into this thread's own padded partial
+    partialSum += localSum;
 }
 
-int main () {
-    // Must be > 1 to show a data race!
-    const int NUM_THREADS = 4;
-    const int NUM_ITERS_PER_THREAD = 1000000 / NUM_THREADS; // Keep total work the same
+/**
+ * @brief Race-free worker: sums draws [first, first + iterations) of the logical stream.
+ * The engine is a local copy, so nothing mutable is shared with other threads.
+ */
+template <typename Engine>
+void stream_worker (long long& partialSum, Engine engine, std::uint64_t iterations) {
+    long long localSum = 0;
 
-    std::atomic<long long> totalSum(0);
-    std::vector<std::thread> threads;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        localSum += rng_streams::bounded(engine(), DRAW_RANGE);
+    }
 
-    // --- Start Timing ---
-    auto start = std::chrono::high_resolution_clock::now();
-
-    // Launch threads
-    for (int i = 0; i < NUM_THREADS; ++i) {
-        // Correct way to launch the thread:
-        // Pass the function, then its arguments.
-        // std::ref() is needed for references (like the atomic)
-        threads.push_back(
-            std::thread(worker, std::ref(totalSum), NUM_ITERS_PER_THREAD)
-        );
+    partialSum += localSum;
+}
+
+/**
+ * @brief Run the stream-split summation on 'num_threads' threads.
+ * @return The total sum, identical for every thread count.
+ */
+long long run_streams(Mode mode, unsigned num_threads) {
+    // Each thread sums into its own cache-line-padded partial; the partials
+    // are combined once at the end instead of through a shared atomic.
+    return parallel::parallel_reduce(num_threads, 0LL, std::plus<>{},
+        [mode, num_threads](unsigned i, long long& partialSum) {
+            const auto first = rng_streams::chunk_begin(TOTAL_ITERS, num_threads, i);
+            const auto count = rng_streams::chunk_begin(TOTAL_ITERS, num_threads, i + 1) - first;
+
+            if (mode == Mode::Discard) {
+                stream_worker(partialSum, rng_streams::make_mt19937_stream(SEED, first), count);
+            } else {
+                stream_worker(partialSum, rng_streams::make_philox_stream(SEED, first), count);
+            }
+        });
+}
+
+int main (int argc, char* argv[]) {
+    Mode mode = Mode::Shared;
+    if (argc > 1) {
+        const std::string arg = argv[1];
+        if (arg == "discard") {
+            mode = Mode::Discard;
+        } else if (arg == "philox") {
+            mode = Mode::Philox;
+        } else if (arg != "shared") {
+            std::cerr << "Usage: " << argv[0] << " [shared|discard|philox] [num_threads]\n";
+            return 1;
+        }
     }
 
-    // Wait for all threads to finish
-    for (std::size_t i = 0; i < threads.size(); ++i) {
-        threads[i].join();
+    // Must be > 1 to show a data race!
+    const int NUM_THREADS = argc > 2 ? std::stoi(argv[2]) : 4;
+    if (NUM_THREADS < 1) {
+        std::cerr << "num_threads must be >= 1\n";
+        return 1;
     }
 
+    if (mode != Mode::Shared) {
+        // Reference: the same logical stream consumed by one thread
+        const long long reference = run_streams(mode, 1);
+
+        perf::ScopedProfiler prof("run_streams");
+        const long long sum = run_streams(mode, NUM_THREADS);
+        const perf::Sample timed = prof.stop();
+
+        std::cout << "Mode: " << (mode == Mode::Discard ? "mt19937 discard (reference only, O(offset) skip, does not scale)"
+                                                 : "Philox counter-based") << std::endl;
+        std::cout << "Reference sum (1 thread) = " << reference << std::endl;
+        std::cout << "Actual total sum from " << NUM_THREADS << " threads = " << sum
+                  << (sum == reference ? "  [MATCH]" : "  [MISMATCH]") << std::endl;
+        std::cout << "Time taken: " << timed.wall_s << " seconds" << std::endl;
+        std::cout << perf::format(prof.label(), timed) << std::endl;
+        return sum == reference ? 0 : 2;
+    }
+
+    const int NUM_ITERS_PER_THREAD = TOTAL_ITERS / NUM_THREADS; // Keep total work the same
+
+    // --- Start Timing ---
+    // (wall clock plus CPU time, context switches and, where perf events are
+    // available, cycles / instructions / cache and branch misses)
+    perf::ScopedProfiler prof("shared gen");
+
+    // Launch threads and wait for all of them to finish.
+    // parallel_reduce gives each thread a private, cache-line-padded partial sum
+    // and adds the partials together after the join, so the only shared
+    // mutable state left is the (deliberately racy) 'gen'/'dist'.
+    const long long totalSum = parallel::parallel_reduce(NUM_THREADS, 0LL, std::plus<>{},
+        [NUM_ITERS_PER_THREAD](unsigned, long long& partialSum) {
+            worker(partialSum, NUM_ITERS_PER_THREAD);
+        });
+
     // --- Stop Timing ---
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> diff = end - start;
+    const perf::Sample timed = prof.stop();
 
     // Print the final result *after* all threads are joined
     std::cout << "Target sum (from 1 thread) = 50460531" << std::endl;
-    std::cout << "Actual total sum from " << NUM_THREADS << " threads = " << totalSum.load() << std::endl;
-    std::cout << "Time taken: " << diff.count() << " seconds" << std::endl;
+    std::cout << "Actual total sum from " << NUM_THREADS << " threads = " << totalSum << std::endl;
+    std::cout << "Time taken: " << timed.wall_s << " seconds" << std::endl;
+    std::cout << perf::format(prof.label(), timed) << std::endl;
 
     return 0;
-}
\ No newline at end of file
+}
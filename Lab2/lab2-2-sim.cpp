@@ -0,0 +1,137 @@
+/**
+ * Dining philosophers strategy comparison (see dining.hpp).
+ *
+ * Runs the table with each selected strategy and prints meals per second,
+ * p50/p99/max wait-for-chopsticks latency and fairness, then one line of
+ * CPU time, context switches and hardware counters per strategy
+ * (common/perf_counters.hpp).
+ *
+ * Usage: ./lab2-2-sim [--strategy all|hierarchy|waiter|chandy-misra|backoff|scoped|atomic-mask]
+ *                     [--philosophers 5] [--seconds 1] [--meals 0]
+ *                     [--think-us 50,150] [--eat-us 100] [--pause-us 0]
+ *                     [--mode real|virtual] [--trace 0|1] [--preset lab2-2]
+ * --meals N runs until every philosopher has eaten N times instead of for a fixed time.
+ * --mode virtual runs the discrete-event simulation (dining_des.hpp): same cycle,
+ *   simulated clock, no real sleeping. --trace 1 prints lab2-2 style messages
+ *   with simulated timestamps (virtual mode only).
+ * --preset lab2-2 loads the original timings (5 philosophers, 3 meals, think
+ *   100-300 ms, 500 ms pause between chopsticks, 3 s eating); later flags override it.
+ * Compile: g++ -std=c++20 -O2 -pthread lab2-2-sim.cpp -o lab2-2-sim
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include "dining.hpp"
+#include "dining_des.hpp"
+#include "../common/perf_counters.hpp"
+
+void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [--strategy all|hierarchy|waiter|chandy-misra|backoff|scoped|atomic-mask]"
+              << " [--philosophers N] [--seconds S] [--meals M] [--think-us MIN,MAX] [--eat-us E]"
+              << " [--pause-us P] [--mode real|virtual] [--trace 0|1] [--preset lab2-2]\n";
+}
+
+int main(int argc, char* argv[]) {
+    dining::Config cfg;
+    std::string strategy = "all";
+    bool virtual_time = false;
+    bool trace = false;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string flag = argv[i];
+        const std::string value = argv[i + 1];
+        if (flag == "--strategy") {
+            strategy = value;
+        } else if (flag == "--philosophers") {
+            cfg.philosophers = std::stoi(value);
+        } else if (flag == "--seconds") {
+            cfg.duration = std::chrono::milliseconds(static_cast<long long>(std::stod(value) * 1000));
+        } else if (flag == "--meals") {
+            cfg.meals = std::stoi(value);
+        } else if (flag == "--think-us") {
+            const auto comma = value.find(',');
+            cfg.think_min = dining::us(std::stoll(value.substr(0, comma)));
+            cfg.think_max = comma == std::string::npos ? cfg.think_min
+                                                       : dining::us(std::stoll(value.substr(comma + 1)));
+        } else if (flag == "--eat-us") {
+            cfg.eat = dining::us(std::stoll(value));
+        } else if (flag == "--pause-us") {
+            cfg.pick_pause = dining::us(std::stoll(value));
+        } else if (flag == "--mode" && (value == "real" || value == "virtual")) {
+            virtual_time = value == "virtual";
+        } else if (flag == "--trace") {
+            trace = value == "1";
+        } else if (flag == "--preset" && value == "lab2-2") {
+            cfg.philosophers = 5;
+            cfg.meals = 3;
+            cfg.think_min = dining::us(100'000);
+            cfg.think_max = dining::us(300'000);
+            cfg.pick_pause = dining::us(500'000);
+            cfg.eat = dining::us(3'000'000);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (argc % 2 == 0 || cfg.philosophers < 2 || cfg.think_max < cfg.think_min) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<std::string> names;
+    if (strategy == "all") {
+        names = dining::strategy_names();
+    } else {
+        names.push_back(strategy);
+    }
+
+    std::cout << "philosophers=" << cfg.philosophers
+              << (cfg.meals > 0 ? " meals=" + std::to_string(cfg.meals)
+                                : " seconds=" + std::to_string(cfg.duration.count() / 1000.0))
+              << " think=" << cfg.think_min.count() << ".." << cfg.think_max.count() << "us"
+              << " eat=" << cfg.eat.count() << "us"
+              << " pause=" << cfg.pick_pause.count() << "us"
+              << (virtual_time ? " [virtual time]" : "") << "\n";
+    std::cout << std::left << std::setw(14) << "strategy" << std::right
+              << std::setw(12) << "meals/s"
+              << std::setw(12) << "p50 us"
+              << std::setw(12) << "p99 us"
+              << std::setw(12) << "max us"
+              << std::setw(10) << "jain"
+              << std::setw(11) << "min meals"
+              << std::setw(12) << "sim s"
+              << std::setw(12) << "wall ms" << "\n";
+
+    std::vector<std::string> counter_lines;
+    for (const auto& name : names) {
+        auto s = dining::make_strategy(name, cfg.philosophers);
+        if (!s) {
+            std::cerr << "Unknown strategy: " << name << "\n";
+            return 1;
+        }
+        perf::ScopedProfiler prof(name);
+        const dining::Report r = virtual_time ? dining::run_virtual(name, cfg, trace ? &std::cout : nullptr)
+                                              : dining::run(*s, cfg);
+        const perf::Sample timed = prof.stop();
+        counter_lines.push_back(perf::format(name, timed));
+        std::cout << std::left << std::setw(14) << r.strategy << std::right
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(12) << r.meals_per_sec
+                  << std::setw(12) << r.wait_p50_us
+                  << std::setw(12) << r.wait_p99_us
+                  << std::setw(12) << r.wait_max_us
+                  << std::setprecision(3) << std::setw(10) << r.jain_fairness
+                  << std::setw(11) << r.min_meals
+                  << std::setw(12) << r.seconds
+                  << std::setw(12) << timed.wall_s * 1000.0 << "\n";
+    }
+
+    std::cout << "\n";
+    for (const auto& line : counter_lines) {
+        std::cout << line << "\n";
+    }
+    return 0;
+}
@@ -23,13 +23,16 @@
 #include <vector>
 #include <chrono>
 
-// Mutex for thread-safe printing
-std::mutex print_mutex;
-
-void thrd_print(const std::string &str) {
-    // Thread safe print function
-    std::lock_guard<std::mutex> lock(print_mutex);
-    std::cout << str;
+#include "../common/async_log.hpp"
+#include "../common/perf_counters.hpp"
+
+// Thread safe print function.
+// Instead of locking a mutex around std::cout, each message is queued (format
+// string + raw arguments, no std::string building) and a background thread
+// writes the messages out in batches. "{}" marks where an argument goes.
+template <typename... Args>
+void thrd_print(const char* fmt, const Args&... args) {
+    async_log::log(fmt, args...);
 }
 
 const int NUM_PHILOSOPHERS = 5;
@@ -42,51 +45,51 @@ void philosopher(int philosopher_id) {
     int myRightChopstick = (philosopher_id + 1) % NUM_PHILOSOPHERS;
 
     for (int i = 0; i < 3; ++i) {
-        thrd_print("Philosopher " + std::to_string(philosopher_id) + " is thinking.\n");
+        thrd_print("Philosopher {} is thinking.\n", philosopher_id);
         // Add a small random think time
         std::this_thread::sleep_for(std::chrono::milliseconds(100 + (rand() % 200)));
 
         // ASYMMETRIC SOLUTION: The last philosopher picks up in reverse order
         if (philosopher_id == NUM_PHILOSOPHERS - 1) {
             // LAST PHILOSOPHER: Pick up RIGHT, then LEFT
-            thrd_print("Philosopher " + std::to_string(philosopher_id) + " (asymmetric) tries to pick up 1st (RIGHT) chopstick ID " + std::to_string(myRightChopstick) + "\n");
+            thrd_print("Philosopher {} (asymmetric) tries to pick up 1st (RIGHT) chopstick ID {}\n", philosopher_id, myRightChopstick);
             std::lock_guard<std::mutex> rightLock(mtxCS[myRightChopstick]);
-            thrd_print("Philosopher " + std::to_string(philosopher_id) + " GOT (RIGHT) chopstick ID " + std::to_string(myRightChopstick) + "\n");
+            thrd_print("Philosopher {} GOT (RIGHT) chopstick ID {}\n", philosopher_id, myRightChopstick);
 
             std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
-            thrd_print("Philosopher " + std::to_string(philosopher_id) + " has cs Id " + std::to_string(myRightChopstick) + ", tries to pick up (LEFT) ID " + std::to_string(myLeftChopstick) + "\n");
+            thrd_print("Philosopher {} has cs Id {}, tries to pick up (LEFT) ID {}\n", philosopher_id, myRightChopstick, myLeftChopstick);
             std::lock_guard<std::mutex> leftLock(mtxCS[myLeftChopstick]);
-            thrd_print("Philosopher " + std::to_string(philosopher_id) + " GOT (LEFT) chopstick ID " + std::to_string(myLeftChopstick) + "\n");
+            thrd_print("Philosopher {} GOT (LEFT) chopstick ID {}\n", philosopher_id, myLeftChopstick);
 
         } else {
             // ALL OTHER PHILOSOPHERS: Pick up LEFT, then RIGHT
-            thrd_print("Philosopher " + std::to_string(philosopher_id) + " tries to pick up 1st (LEFT) chopstick ID " + std::to_string(myLeftChopstick) + "\n");
+            thrd_print("Philosopher {} tries to pick up 1st (LEFT) chopstick ID {}\n", philosopher_id, myLeftChopstick);
             std::lock_guard<std::mutex> leftLock(mtxCS[myLeftChopstick]);
-            thrd_print("Philosopher " + std::to_string(philosopher_id) + " GOT (LEFT) chopstick ID " + std::to_string(myLeftChopstick) + "\n");
+            thrd_print("Philosopher {} GOT (LEFT) chopstick ID {}\n", philosopher_id, myLeftChopstick);
 
             std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
-            thrd_print("Philosopher " + std::to_string(philosopher_id) + " has cs Id " + std::to_string(myLeftChopstick) + ", tries to pick up (RIGHT) ID " + std::to_string(myRightChopstick) + "\n");
+            thrd_print("Philosopher {} has cs Id {}, tries to pick up (RIGHT) ID {}\n", philosopher_id, myLeftChopstick, myRightChopstick);
             std::lock_guard<std::mutex> rightLock(mtxCS[myRightChopstick]);
-            thrd_print("Philosopher " + std::to_string(philosopher_id) + " GOT (RIGHT) chopstick ID " + std::to_string(myRightChopstick) + "\n");
+            thrd_print("Philosopher {} GOT (RIGHT) chopstick ID {}\n", philosopher_id, myRightChopstick);
         }
 
 
         // She has two chopsticks. Eating time!
-        thrd_print("Philosopher " + std::to_string(philosopher_id) + " is EATING for 3 secs!\n");
+        thrd_print("Philosopher {} is EATING for 3 secs!\n", philosopher_id);
         std::this_thread::sleep_for(std::chrono::milliseconds(3000));
 
-        thrd_print("Philosopher " + std::to_string(philosopher_id) + " is putting down chopsticks.\n");
+        thrd_print("Philosopher {} is putting down chopsticks.\n", philosopher_id);
         // Both lock_guards go out of scope here, releasing the mutexes
     }
-    thrd_print("Philosopher " + std::to_string(philosopher_id) + " is FINISHED and leaving.\n");
+    thrd_print("Philosopher {} is FINISHED and leaving.\n", philosopher_id);
 }
 
 int main() {
     std::thread athrdPhilosophers[NUM_PHILOSOPHERS];
 
-    auto start = std::chrono::high_resolution_clock::now();
+    perf::ScopedProfiler prof("philosophers");
 
     for (int i = 0; i < NUM_PHILOSOPHERS; ++i) {
         // Corrected thread creation
@@ -97,13 +100,16 @@ int main() {
         p.join();
     }
 
-    auto end = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> diff = end - start;
+    const perf::Sample timed = prof.stop();
 
     // This line WILL be reached
     thrd_print("------------------------------------------\n");
     thrd_print("All philosophers finished eating.\n");
-    thrd_print("Total execution time: " + std::to_string(diff.count()) + " s\n");
+    thrd_print("Total execution time: {} s\n", timed.wall_s);
+
+    // The counter report is longer than a log slot holds, so print it after the log drains
+    async_log::logger().flush();
+    std::cout << perf::format(prof.label(), timed) << std::endl;
 
     return 0;
 }
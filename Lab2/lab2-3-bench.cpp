@@ -0,0 +1,141 @@
+/**
+ * Contention benchmark for RandomTwister.
+ *
+ * Every thread calls generate() in a tight loop on one shared RandomTwister
+ * (passed with std::ref, exactly like lab2-3). The mutex-guarded mode, the
+ * sharded per-thread-engine mode and the background-producer ring mode are
+ * compared from 1 thread up to std::thread::hardware_concurrency().
+ * Producer-mode underruns are reported so ring sizes can be tuned, along with
+ * fallbacks: calls served by the locked engine because more threads were alive
+ * than the twister has ring slots.
+ * Before timing, generate_batch() output is checked to lie in [min, max);
+ * the program exits with status 1 if it does not.
+ *
+ * Usage: ./lab2-3-bench [calls_per_thread] [max_threads] [ring_capacity] [low_water]
+ * Compile: g++ -std=c++20 -O2 -pthread lab2-3-bench.cpp -o lab2-3-bench
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <latch>
+#include <string>
+#include <functional>   // For std::ref
+#include <algorithm>
+#include <utility>
+
+#include "random_twister.hpp"
+
+// Keeps the compiler from discarding the generated values
+std::atomic<float> sink{0.0f};
+
+void hammer(RandomTwister& r, std::latch& go, long calls) {
+    float acc = 0.0f;
+    go.arrive_and_wait(); // all threads start together
+    for (long i = 0; i < calls; ++i) {
+        acc += r.generate();
+    }
+    sink.fetch_add(acc, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Run 'num_threads' threads against one twister.
+ * @return Throughput in million generate() calls per second.
+ */
+double run(RandomTwister::Mode mode, unsigned num_threads, long calls,
+           RandomTwister::ProducerConfig config = {}, RandomTwister::ProducerStats* stats = nullptr) {
+    RandomTwister generator(1.0f, 5.0f, mode, 12345u, config);
+    std::latch go(num_threads + 1);
+    std::vector<std::thread> threads;
+
+    for (unsigned i = 0; i < num_threads; ++i) {
+        threads.push_back(std::thread(hammer, std::ref(generator), std::ref(go), calls));
+    }
+
+    // Timing starts once every thread exists, so creation cost is excluded
+    auto start = std::chrono::steady_clock::now();
+    go.arrive_and_wait();
+    for (auto& t : threads) {
+        t.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    const std::chrono::duration<double> diff = end - start;
+    if (stats != nullptr) {
+        *stats = generator.producer_stats();
+    }
+    return static_cast<double>(calls) * num_threads / diff.count() / 1e6;
+}
+
+/**
+ * @brief Check that batch conversion stays inside [min, max).
+ * The largest engine output is tried directly, because min + x * scale rounds
+ * up to max for some ranges (the lab's own 1..5 among them), and a batch of
+ * draws covers the ordinary values.
+ * @return true if every range passed.
+ */
+bool check_range() {
+    const std::pair<float, float> ranges[] = {{1.0f, 5.0f}, {0.0f, 1.0f}, {-1.0f, 1.0f}, {3.0f, 7.0f}};
+    bool ok = true;
+    for (const auto& [lo, hi] : ranges) {
+        RandomTwister r(lo, hi, RandomTwister::Mode::Locked, 12345u);
+        std::vector<float> batch(1 << 16);
+        r.generate_batch(batch);
+        batch.push_back(r.to_range(0xFFFFFFFFu));
+        batch.push_back(r.to_range(0u));
+        const auto [mn, mx] = std::minmax_element(batch.begin(), batch.end());
+        if (*mn < lo || *mx >= hi) {
+            std::cerr << "range check failed for [" << lo << ", " << hi << "): got "
+                      << std::setprecision(9) << *mn << " .. " << *mx << "\n";
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    if (!check_range()) {
+        return 1;
+    }
+
+    const long calls = argc > 1 ? std::stol(argv[1]) : 1'000'000;
+    unsigned max_threads = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2]))
+                                    : std::thread::hardware_concurrency();
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+    RandomTwister::ProducerConfig config;
+    if (argc > 3) {
+        config.capacity = std::stoul(argv[3]);
+    }
+    if (argc > 4) {
+        config.low_water = std::stoul(argv[4]);
+    }
+
+    std::cout << "calls/thread=" << calls << " max_threads=" << max_threads << "\n";
+    std::cout << std::setw(8) << "threads"
+              << std::setw(16) << "mutex Mops/s"
+              << std::setw(16) << "sharded Mops/s"
+              << std::setw(10) << "speedup"
+              << std::setw(16) << "producer Mops/s"
+              << std::setw(11) << "underruns"
+              << std::setw(11) << "fallbacks" << "\n";
+
+    for (unsigned n = 1; n <= max_threads; ++n) {
+        const double locked = run(RandomTwister::Mode::Locked, n, calls);
+        const double sharded = run(RandomTwister::Mode::Sharded, n, calls);
+        RandomTwister::ProducerStats stats;
+        const double produced = run(RandomTwister::Mode::Producer, n, calls, config, &stats);
+        std::cout << std::fixed << std::setprecision(2)
+                  << std::setw(8) << n
+                  << std::setw(16) << locked
+                  << std::setw(16) << sharded
+                  << std::setw(10) << sharded / locked
+                  << std::setw(16) << produced
+                  << std::setw(11) << stats.underruns
+                  << std::setw(11) << stats.fallbacks << "\n";
+    }
+    return 0;
+}
@@ -2,56 +2,43 @@
 #include <thread>
 #include <vector>
 #include <random>       // Provides std::uniform_real_distribution and std:mt19937
-#include <chrono>
-#include <mutex>
-#include <sstream>
+#include <string>
 
-// This mutex protects std::cout
-std::mutex cout_mutex;
+#include "random_twister.hpp"
+#include "../common/async_log.hpp"
+#include "../common/perf_counters.hpp"
 
-void safe_print(const std::string& msg) {
-    std::lock_guard<std::mutex> lock(cout_mutex);
-    std::cout << msg << std::endl;
+// Thread safe print.
+// Messages go through the async logger instead of a mutex around std::cout:
+// the caller only copies the format and arguments into a preallocated slot,
+// and a background thread formats and writes them ("{}" = next argument).
+template <typename... Args>
+void safe_print(const char* fmt, const Args&... args) {
+    async_log::log(fmt, args...);
 }
 
-class RandomTwister {
-    public:
-        // Constructor to initialise the random generator with a specific range
-        // FIX: Initialize both members in the initializer list.
-        //      The engine is seeded using std::random_device for a non-deterministic seed.
-        RandomTwister (float min, float max)
-            : distribution(min, max), engine(std::random_device{}()) {}
-
-        // Returns a random float within the specified range
-        float generate() {
-            // CRITICAL FIX: Add a lock_guard to make this method thread-safe.
-            // This prevents multiple threads from accessing the 'engine' at the same time,
-            // which would cause a data race.
-            std::lock_guard<std::mutex> lock(gen_mutex_);
-            return distribution(engine);
-        }
-
-    private:
-        // FIX: Add a mutex for thread-safety
-        std::mutex gen_mutex_;
-
-        // FIX: Correctly declare members.
-        std::mt19937 engine;
-        std::uniform_real_distribution<float> distribution;
-};
-
 void generateAndPrintRandom(RandomTwister& r) {
-    std::ostringstream oss;
-    
     // FIX: Add a space for readability and remove extra semicolon
-    oss << "Random Float: " << r.generate();
-    
-    std::string msg = oss.str(); // Convert to a string
-    safe_print(msg);
+    // (no ostringstream / std::string needed any more)
+    safe_print("Random Float: {}\n", r.generate());
 }
 
-int main () {
-    RandomTwister generator (1.0f, 5.0f); // Random floats between 1.0 and 5.0 
+// Usage: ./lab2-3 [locked|sharded|producer]
+int main (int argc, char* argv[]) {
+    RandomTwister::Mode mode = RandomTwister::Mode::Locked;
+    if (argc > 1) {
+        const std::string arg = argv[1];
+        if (arg == "sharded") {
+            mode = RandomTwister::Mode::Sharded;
+        } else if (arg == "producer") {
+            mode = RandomTwister::Mode::Producer;
+        } else if (arg != "locked") {
+            std::cerr << "Usage: " << argv[0] << " [locked|sharded|producer]\n";
+            return 1;
+        }
+    }
+
+    RandomTwister generator (1.0f, 5.0f, mode); // Random floats between 1.0 and 5.0 
     std::vector<std::thread> threads;
 
     for (int i = 0; i < 5; ++i) {
@@ -62,5 +49,33 @@ int main () {
         thread.join();
     }
 
+    // Throughput: one locked call per value vs one locked call per buffer
+    const std::size_t COUNT = 4'000'000;
+    std::vector<float> buffer(COUNT);
+
+    perf::ScopedProfiler single_prof("generate()");
+    for (auto& v : buffer) {
+        v = generator.generate();
+    }
+    const perf::Sample single = single_prof.stop();
+    perf::ScopedProfiler batch_prof("generate_batch()");
+    generator.generate_batch(buffer);
+    const perf::Sample batch = batch_prof.stop();
+
+    safe_print("generate():       {} Mfloats/s\n", COUNT / single.wall_s / 1e6);
+    safe_print("generate_batch(): {} Mfloats/s (x{})\n", COUNT / batch.wall_s / 1e6,
+               single.wall_s / batch.wall_s);
+
+    if (mode == RandomTwister::Mode::Producer) {
+        const auto stats = generator.producer_stats();
+        safe_print("Producer: consumers={} refills={} produced={} underruns={} fallbacks={}\n",
+                   stats.consumers, stats.refills, stats.produced, stats.underruns, stats.fallbacks);
+    }
+
+    // Counter reports are longer than a log slot holds, so print them after the log drains
+    async_log::logger().flush();
+    std::cout << perf::format(single_prof.label(), single) << "\n"
+              << perf::format(batch_prof.label(), batch) << std::endl;
+
     return 0;
 }
@@ -0,0 +1,204 @@
+/**
+ * std::mutex vs parallel::AdaptiveMutex on the labs' short critical sections.
+ *
+ * Three call sites, each run with both locks from 1 thread up to twice
+ * std::thread::hardware_concurrency():
+ *   twister - RandomTwister::generate() in Locked mode (lab2-3), i.e.
+ *             BasicRandomTwister<std::mutex> vs BasicRandomTwister<AdaptiveMutex>
+ *   counter - step5's lock_guard around ++counter
+ *   print   - lab2-2's original thrd_print: lock_guard around writing one
+ *             formatted line to a shared stream. lab2-2 now logs through
+ *             async_log without a lock, so the stream here is an in-memory
+ *             std::ostringstream standing in for std::cout (and keeping the
+ *             terminal out of the measurement).
+ *
+ * Reported per run:
+ *   Mops/s  - total operations per second
+ *   p50/p99 - time to acquire the lock, sampled every SAMPLE_EVERY operations
+ *             (twister: the whole generate() call, as the lock is internal)
+ *   ctxsw   - voluntary + involuntary context switches of the process during
+ *             the run (getrusage; not available on Windows, shown as -)
+ *
+ * Usage: ./lab2-lock-bench [ops_per_thread] [max_threads]
+ * Compile: g++ -std=c++20 -O2 -pthread lab2-lock-bench.cpp -o lab2-lock-bench
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "random_twister.hpp"
+#include "../common/adaptive_mutex.hpp"
+#include "../common/perf_counters.hpp" // For perf::usage
+
+using Clock = std::chrono::steady_clock;
+
+constexpr long SAMPLE_EVERY = 64;
+
+// Keeps the compiler from discarding the generated values
+std::atomic<float> sink{0.0f};
+
+struct Result {
+    double mops;
+    double p50_ns;
+    double p99_ns;
+    long ctxsw;
+};
+
+/**
+ * @brief Run 'body(thread, i, sample)' 'ops' times on each of 'num_threads' threads.
+ *        'sample' is true every SAMPLE_EVERY calls; the body then returns the
+ *        nanoseconds it measured, which go into the latency percentiles.
+ */
+template <typename Body>
+Result run(unsigned num_threads, long ops, Body body) {
+    std::latch go(num_threads + 1);
+    std::vector<std::vector<double>> samples(num_threads);
+    std::vector<std::thread> threads;
+
+    for (unsigned t = 0; t < num_threads; ++t) {
+        samples[t].reserve(static_cast<std::size_t>(ops / SAMPLE_EVERY + 1));
+        threads.emplace_back([&, t] {
+            go.arrive_and_wait();
+            for (long i = 0; i < ops; ++i) {
+                const bool sample = i % SAMPLE_EVERY == 0;
+                const double ns = body(t, i, sample);
+                if (sample) {
+                    samples[t].push_back(ns);
+                }
+            }
+        });
+    }
+
+    const perf::Usage before = perf::usage(perf::Scope::Process);
+    const auto start = Clock::now();
+    go.arrive_and_wait();
+    for (auto& th : threads) {
+        th.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const perf::Usage used = perf::usage(perf::Scope::Process) - before;
+
+    std::vector<double> all;
+    for (const auto& s : samples) {
+        all.insert(all.end(), s.begin(), s.end());
+    }
+    std::sort(all.begin(), all.end());
+    const auto at = [&all](double pct) {
+        return all[std::min(all.size() - 1, static_cast<std::size_t>(pct / 100.0 * static_cast<double>(all.size())))];
+    };
+    return {static_cast<double>(ops) * num_threads / seconds / 1e6, at(50), at(99),
+            used.cpu_s < 0.0 ? -1 : used.nvcsw + used.nivcsw};
+}
+
+double since_ns(Clock::time_point t0) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+}
+
+template <typename Mutex>
+Result twister(unsigned num_threads, long ops) {
+    BasicRandomTwister<Mutex> generator(1.0f, 5.0f, BasicRandomTwister<Mutex>::Mode::Locked, 12345u);
+    std::vector<float> acc(num_threads, 0.0f);
+    Result r = run(num_threads, ops, [&](unsigned t, long, bool sample) {
+        if (!sample) {
+            acc[t] += generator.generate();
+            return 0.0;
+        }
+        const auto t0 = Clock::now();
+        acc[t] += generator.generate();
+        return since_ns(t0);
+    });
+    for (const float a : acc) {
+        sink.fetch_add(a, std::memory_order_relaxed);
+    }
+    return r;
+}
+
+template <typename Mutex>
+Result counter(unsigned num_threads, long ops) {
+    Mutex mtx;
+    long long count = 0;
+    Result r = run(num_threads, ops, [&](unsigned, long, bool sample) {
+        if (!sample) {
+            std::lock_guard<Mutex> lock(mtx);
+            ++count;
+            return 0.0;
+        }
+        const auto t0 = Clock::now();
+        std::lock_guard<Mutex> lock(mtx);
+        const double ns = since_ns(t0);
+        ++count;
+        return ns;
+    });
+    if (count != static_cast<long long>(num_threads) * ops) {
+        std::cerr << "counter: lost updates (" << count << ")\n";
+    }
+    return r;
+}
+
+template <typename Mutex>
+Result print(unsigned num_threads, long ops) {
+    Mutex mtx;
+    std::ostringstream out;
+    return run(num_threads, ops, [&](unsigned t, long i, bool sample) {
+        // Formatting happens outside the lock, as in lab2-2's callers
+        const std::string line = "Philosopher " + std::to_string(t) + " is thinking (" + std::to_string(i) + ").\n";
+        const auto t0 = Clock::now();
+        std::lock_guard<Mutex> lock(mtx);
+        const double ns = sample ? since_ns(t0) : 0.0;
+        out << line;
+        if (out.tellp() > (1 << 16)) {
+            out.str(std::string()); // keep the buffer bounded, like a flushed stream
+        }
+        return ns;
+    });
+}
+
+void print_row(const std::string& workload, const char* lock, unsigned threads, const Result& r) {
+    std::cout << std::left << std::setw(9) << workload << std::setw(9) << lock << std::right
+              << std::setw(8) << threads << std::fixed << std::setprecision(2)
+              << std::setw(10) << r.mops << std::setprecision(0)
+              << std::setw(10) << r.p50_ns << std::setw(10) << r.p99_ns << std::setw(10);
+    if (r.ctxsw < 0) {
+        std::cout << "-";
+    } else {
+        std::cout << r.ctxsw;
+    }
+    std::cout << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    const long ops = argc > 1 ? std::stol(argv[1]) : 500'000;
+    if (ops < 1) {
+        std::cerr << "ops_per_thread must be >= 1\n";
+        return 1;
+    }
+    unsigned max_threads = argc > 2 ? static_cast<unsigned>(std::stoul(argv[2]))
+                                    : 2 * std::thread::hardware_concurrency();
+    if (max_threads == 0) {
+        max_threads = 2;
+    }
+
+    std::cout << "ops_per_thread=" << ops << "\n"
+              << std::left << std::setw(9) << "workload" << std::setw(9) << "lock" << std::right
+              << std::setw(8) << "threads" << std::setw(10) << "Mops/s"
+              << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" << std::setw(10) << "ctxsw" << "\n";
+
+    for (unsigned n = 1; n <= max_threads; n *= 2) {
+        print_row("twister", "mutex", n, twister<std::mutex>(n, ops));
+        print_row("twister", "adaptive", n, twister<parallel::AdaptiveMutex>(n, ops));
+        print_row("counter", "mutex", n, counter<std::mutex>(n, ops));
+        print_row("counter", "adaptive", n, counter<parallel::AdaptiveMutex>(n, ops));
+        print_row("print", "mutex", n, print<std::mutex>(n, ops));
+        print_row("print", "adaptive", n, print<parallel::AdaptiveMutex>(n, ops));
+    }
+    return 0;
+}
@@ -0,0 +1,423 @@
+/**
+ * RandomTwister - thread-safe random float generator used by lab2-3.
+ *
+ * Three modes:
+ * - Locked  (default): one engine guarded by a std::mutex, as in the original lab.
+ * - Sharded: every calling thread lazily gets its own cache-line-aligned engine,
+ *            seeded from a master seed sequence. generate() never takes a lock,
+ *            so threads no longer serialise on one mutex. Engines are owned by
+ *            the twister and indexed by the thread's ThreadSlots index, so they
+ *            are freed with the twister and reused by later threads instead of
+ *            piling up in every thread that ever touched a twister.
+ * - Producer: a background refill thread keeps one lock-free SPSC ring buffer
+ *            per consuming thread topped up, so generate() is just a buffer read.
+ *            A ring that drains below the low-water mark wakes the producer; a
+ *            read from an empty ring is counted as an underrun. Rings are
+ *            indexed by ThreadSlots like the shards, so a thread that exits
+ *            hands its ring to the next thread instead of using up a slot.
+ *
+ * With MAX_THREADS or more threads alive at once, the extra threads have no
+ * shard or ring and are served by the locked engine; producer_stats() counts
+ * those calls as fallbacks.
+ *
+ * In every mode the object is shared between threads with std::ref().
+ *
+ * The lock is a template parameter: RandomTwister uses std::mutex, and
+ * BasicRandomTwister<parallel::AdaptiveMutex> (common/adaptive_mutex.hpp)
+ * swaps in a spin-then-park lock for the short generate() critical section.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "sfmt.hpp"
+
+/**
+ * @brief Small process-wide index per live thread, for per-thread slots in
+ *        fixed arrays.
+ *
+ * A thread gets the lowest free index on its first current() call and hands
+ * it back when it exits, so indices stay dense and bounded by the number of
+ * threads alive at once. Handing back and taking a slot both go through one
+ * mutex, so whatever the previous owner wrote into a slot is visible to the
+ * next one.
+ */
+class ThreadSlots {
+    public:
+        static std::size_t current() {
+            thread_local const Holder holder;
+            return holder.index;
+        }
+
+    private:
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::size_t> free;
+            std::size_t next = 0;
+        };
+
+        static Registry& registry() {
+            static Registry r;
+            return r;
+        }
+
+        struct Holder {
+            Holder() {
+                Registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                if (r.free.empty()) {
+                    index = r.next++;
+                } else {
+                    // Lowest free index first, keeping the arrays densely used
+                    std::pop_heap(r.free.begin(), r.free.end(), std::greater<>{});
+                    index = r.free.back();
+                    r.free.pop_back();
+                }
+            }
+
+            ~Holder() {
+                Registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.mutex);
+                r.free.push_back(index);
+                std::push_heap(r.free.begin(), r.free.end(), std::greater<>{});
+            }
+
+            std::size_t index = 0;
+        };
+};
+
+template <typename Mutex = std::mutex>
+class BasicRandomTwister {
+    public:
+        enum class Mode { Locked, Sharded, Producer };
+
+        // Sizing of the per-consumer rings in producer mode
+        struct ProducerConfig {
+            std::size_t capacity = 4096;    // values per ring, rounded up to a power of two
+            std::size_t low_water = 1024;   // refill once a ring holds this many or fewer
+        };
+
+        struct ProducerStats {
+            std::size_t consumers = 0;      // rings created (at most one per live thread)
+            std::uint64_t underruns = 0;    // generate() calls that found their ring empty
+            std::uint64_t fallbacks = 0;    // calls served by the locked engine for lack of a slot
+            std::uint64_t refills = 0;      // ring top-ups done by the producer thread
+            std::uint64_t produced = 0;     // values written into rings
+        };
+
+        // Constructor to initialise the random generator with a specific range
+        // FIX: Initialize both members in the initializer list.
+        //      The engine is seeded using std::random_device for a non-deterministic seed.
+        BasicRandomTwister (float min, float max, Mode mode = Mode::Locked)
+            : BasicRandomTwister(min, max, mode, std::random_device{}()) {}
+
+        // Deterministic variant: shard k is always seeded from (master_seed, k)
+        BasicRandomTwister (float min, float max, Mode mode, std::uint32_t master_seed)
+            : BasicRandomTwister(min, max, mode, master_seed, ProducerConfig{}) {}
+
+        BasicRandomTwister (float min, float max, Mode mode, std::uint32_t master_seed,
+                       ProducerConfig config)
+            : engine(master_seed), distribution(min, max),
+              min_(min), scale_((max - min) * 0x1.0p-24f), below_max_(std::nextafter(max, min)),
+              mode_(mode), master_seed_(master_seed), id_(next_id()),
+              ring_capacity_(std::bit_ceil(std::max<std::size_t>(config.capacity, 2))),
+              low_water_(std::min(config.low_water, ring_capacity_ - 1)) {
+            if (mode_ == Mode::Producer) {
+                producer_ = std::thread(&BasicRandomTwister::producer_loop, this);
+            }
+        }
+
+        // All consumer threads must be finished before the twister is destroyed
+        ~BasicRandomTwister() {
+            if (producer_.joinable()) {
+                stop_.store(true, std::memory_order_relaxed);
+                poke_producer();
+                producer_.join();
+            }
+            for (auto& slot : rings_) {
+                delete slot.load(std::memory_order_relaxed);
+            }
+        }
+
+        BasicRandomTwister(const BasicRandomTwister&) = delete;
+        BasicRandomTwister& operator=(const BasicRandomTwister&) = delete;
+
+        Mode mode() const { return mode_; }
+
+        // Returns a random float within the specified range
+        float generate() {
+            if (mode_ == Mode::Sharded) {
+                if (Shard* s = local_shard()) {
+                    return s->distribution(s->engine);
+                }
+                // More live threads than shard slots: fall through to the locked engine
+                fallbacks_.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (mode_ == Mode::Producer) {
+                if (Ring* ring = local_ring()) {
+                    return pop(*ring);
+                }
+                // More live threads than ring slots: fall through to the locked engine
+                fallbacks_.fetch_add(1, std::memory_order_relaxed);
+            }
+            // CRITICAL FIX: Add a lock_guard to make this method thread-safe.
+            // This prevents multiple threads from accessing the 'engine' at the same time,
+            // which would cause a data race.
+            std::lock_guard<Mutex> lock(gen_mutex_);
+            return distribution(engine);
+        }
+
+        // Fills 'out' with random floats in [min, max) under a single lock acquisition
+        // (no lock at all in sharded mode).
+        // Whole 624-value SFMT blocks are generated with SIMD and converted in one pass,
+        // so the per-value cost is a few instructions instead of a lock round-trip.
+        void generate_batch(std::span<float> out) {
+            if (mode_ == Mode::Sharded) {
+                if (Shard* s = local_shard()) {
+                    fill(s->engine, out);
+                    return;
+                }
+                fallbacks_.fetch_add(1, std::memory_order_relaxed);
+            }
+            std::lock_guard<Mutex> lock(gen_mutex_);
+            fill(engine, out);
+        }
+
+        // Maps one raw 32-bit engine output into [min, max), exactly as
+        // generate_batch() does for every value it writes.
+        float to_range(std::uint32_t raw) const {
+            // min + x * scale can round up to max itself (e.g. 5.0f for 1..5),
+            // so clamp to the largest float below max.
+            return std::min(min_ + static_cast<float>(raw >> 8) * scale_, below_max_);
+        }
+
+        // Number of per-thread engines created so far (sharded mode)
+        std::size_t shard_count() const {
+            return next_shard_.load(std::memory_order_relaxed);
+        }
+
+        // Snapshot of producer-mode counters; safe to call at any time
+        ProducerStats producer_stats() const {
+            ProducerStats stats;
+            const std::size_t n = ring_slots_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (const Ring* ring = rings_[i].load(std::memory_order_acquire)) {
+                    stats.consumers++;
+                    stats.underruns += ring->underruns.load(std::memory_order_relaxed);
+                }
+            }
+            stats.fallbacks = fallbacks_.load(std::memory_order_relaxed);
+            stats.refills = refills_.load(std::memory_order_relaxed);
+            stats.produced = produced_.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+    private:
+        static constexpr std::size_t CACHE_LINE = 64;
+        static constexpr std::size_t MAX_THREADS = 256;     // live threads with a shard or ring
+
+        // One engine per thread. Aligned so two shards never share a cache line.
+        struct alignas(CACHE_LINE) Shard {
+            Shard(std::uint32_t seed, float min, float max)
+                : engine(seed), distribution(min, max) {}
+
+            Sfmt19937 engine;
+            std::uniform_real_distribution<float> distribution;
+        };
+
+        // Single-producer/single-consumer ring. head is only written by the
+        // consumer, tail only by the producer thread, each on its own cache line.
+        struct alignas(CACHE_LINE) Ring {
+            explicit Ring(std::size_t capacity) : buffer(capacity), mask(capacity - 1) {}
+
+            alignas(CACHE_LINE) std::atomic<std::size_t> head{0};
+            alignas(CACHE_LINE) std::atomic<std::size_t> tail{0};
+            alignas(CACHE_LINE) std::atomic<std::uint64_t> underruns{0};
+            std::vector<float> buffer;
+            std::size_t mask;
+        };
+
+        // FIX: Add a mutex for thread-safety
+        // (in producer mode it guards 'engine' between the refill thread and
+        // generate_batch()/overflow callers)
+        Mutex gen_mutex_;
+
+        // FIX: Correctly declare members.
+        // SFMT19937 has the same period as std::mt19937 but regenerates its
+        // state a whole block at a time, which is what generate_batch() relies on.
+        Sfmt19937 engine;
+        std::uniform_real_distribution<float> distribution;
+
+        // Batch conversion: top 24 bits -> [0, 1) exactly, then scale into [min, max).
+        float min_;
+        float scale_;
+        float below_max_;
+
+        Mode mode_;
+        std::uint32_t master_seed_;
+        std::uint64_t id_;
+        std::atomic<std::uint32_t> next_shard_{0};
+        std::array<std::unique_ptr<Shard>, MAX_THREADS> shards_{};  // by ThreadSlots index
+
+        // Producer mode
+        std::size_t ring_capacity_;
+        std::size_t low_water_;
+        std::array<std::atomic<Ring*>, MAX_THREADS> rings_{};        // by ThreadSlots index
+        std::atomic<std::size_t> ring_slots_{0};    // one past the highest slot with a ring
+        std::atomic<std::uint64_t> fallbacks_{0};
+        std::atomic<std::uint32_t> wake_{0};
+        std::atomic<bool> stop_{false};
+        std::atomic<std::uint64_t> refills_{0};
+        std::atomic<std::uint64_t> produced_{0};
+        std::thread producer_;
+
+        static std::uint64_t next_id() {
+            static std::atomic<std::uint64_t> counter{0};
+            return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        // Shard of the calling thread, created on first use. Only the thread
+        // holding a slot touches shards_[slot]; a thread that exits leaves its
+        // shard to the next thread given the slot, and the twister frees them all.
+        // Returns nullptr while MAX_THREADS or more threads are alive.
+        Shard* local_shard() {
+            const std::size_t slot = ThreadSlots::current();
+            if (slot >= MAX_THREADS) {
+                return nullptr;
+            }
+            auto& shard = shards_[slot];
+            if (!shard) {
+                // seed_seq decorrelates neighbouring shard seeds
+                const std::uint32_t index = next_shard_.fetch_add(1, std::memory_order_relaxed);
+                std::seed_seq seq{master_seed_, index};
+                std::uint32_t seed;
+                seq.generate(&seed, &seed + 1);
+                shard = std::make_unique<Shard>(seed, distribution.a(), distribution.b());
+            }
+            return shard.get();
+        }
+
+        // Ring of the calling thread, created and pre-filled on first use.
+        // Indexed like the shards: a thread that exits leaves its ring, and
+        // whatever is still buffered in it, to the next thread given the slot.
+        // Returns nullptr while MAX_THREADS or more threads are alive.
+        Ring* local_ring() {
+            const std::size_t slot = ThreadSlots::current();
+            if (slot >= MAX_THREADS) {
+                return nullptr;
+            }
+            Ring* ring = rings_[slot].load(std::memory_order_relaxed);
+            if (ring == nullptr) {
+                // Not yet visible to the producer, so we may fill it ourselves
+                ring = new Ring(ring_capacity_);
+                {
+                    std::lock_guard<Mutex> lock(gen_mutex_);
+                    fill(engine, ring->buffer);
+                }
+                ring->tail.store(ring_capacity_, std::memory_order_relaxed);
+                rings_[slot].store(ring, std::memory_order_release);
+                std::size_t n = ring_slots_.load(std::memory_order_relaxed);
+                while (n < slot + 1
+                       && !ring_slots_.compare_exchange_weak(n, slot + 1, std::memory_order_release,
+                                                             std::memory_order_relaxed)) {
+                }
+            }
+            return ring;
+        }
+
+        float pop(Ring& ring) {
+            const std::size_t h = ring.head.load(std::memory_order_relaxed);
+            std::size_t t = ring.tail.load(std::memory_order_acquire);
+            if (h == t) {
+                ring.underruns.fetch_add(1, std::memory_order_relaxed);
+                poke_producer();
+                while ((t = ring.tail.load(std::memory_order_acquire)) == h) {
+                    std::this_thread::yield();
+                }
+            }
+            const float value = ring.buffer[h & ring.mask];
+            ring.head.store(h + 1, std::memory_order_release);
+            if (t - (h + 1) == low_water_) {
+                poke_producer();
+            }
+            return value;
+        }
+
+        void poke_producer() {
+            wake_.fetch_add(1, std::memory_order_release);
+            wake_.notify_one();
+        }
+
+        // Tops up every ring at or below the low-water mark, then sleeps until poked
+        void producer_loop() {
+            while (!stop_.load(std::memory_order_relaxed)) {
+                const std::uint32_t seen = wake_.load(std::memory_order_acquire);
+                bool refilled = false;
+
+                const std::size_t n = ring_slots_.load(std::memory_order_acquire);
+                for (std::size_t i = 0; i < n; ++i) {
+                    Ring* ring = rings_[i].load(std::memory_order_acquire);
+                    if (ring == nullptr) {
+                        continue; // slot never used, or its ring still being pre-filled
+                    }
+                    const std::size_t t = ring->tail.load(std::memory_order_relaxed);
+                    const std::size_t h = ring->head.load(std::memory_order_acquire);
+                    if (t - h > low_water_) {
+                        continue;
+                    }
+                    // Free space may wrap around the end of the buffer: fill in two spans
+                    const std::size_t free_slots = ring_capacity_ - (t - h);
+                    const std::size_t start = t & ring->mask;
+                    const std::size_t first = std::min(free_slots, ring_capacity_ - start);
+                    {
+                        std::lock_guard<Mutex> lock(gen_mutex_);
+                        fill(engine, std::span<float>(ring->buffer).subspan(start, first));
+                        fill(engine, std::span<float>(ring->buffer).first(free_slots - first));
+                    }
+                    ring->tail.store(t + free_slots, std::memory_order_release);
+                    refills_.fetch_add(1, std::memory_order_relaxed);
+                    produced_.fetch_add(free_slots, std::memory_order_relaxed);
+                    refilled = true;
+                }
+
+                if (!refilled) {
+                    wake_.wait(seen, std::memory_order_acquire);
+                }
+            }
+        }
+
+        void fill(Sfmt19937& e, std::span<float> out) const {
+            std::size_t done = 0;
+            while (done < out.size()) {
+                if (e.buffered() == 0) {
+                    e.refill();
+                }
+                const std::size_t n = std::min(e.buffered(), out.size() - done);
+                convert(e.take(n), out.data() + done, n);
+                done += n;
+            }
+        }
+
+        void convert(const std::uint32_t* in, float* out, std::size_t n) const {
+            // Plain loop on purpose: compilers vectorise it (8 lanes with AVX2).
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = to_range(in[i]);
+            }
+        }
+};
+
+using RandomTwister = BasicRandomTwister<>;
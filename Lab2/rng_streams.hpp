@@ -0,0 +1,143 @@
+/**
+ * Reproducible parallel random number streams.
+ *
+ * One logical random sequence is split into per-thread sub-streams so that
+ * N threads together consume exactly the draws a single thread would have
+ * consumed. No engine state is shared between threads, so there is no data
+ * race and no cache-line ping-pong on the generator.
+ *
+ * Two ways of splitting are provided:
+ * 1. Discard: each thread takes a private copy of the seeded std::mt19937
+ *    and discard()s up to its first draw. Same sequence as the original lab
+ *    code, but the skip costs O(offset), so the total skipping grows with the
+ *    thread count. A reproducibility reference, not a scalable split (a real
+ *    mt19937 jump needs a GF(2) jump polynomial, which is not implemented).
+ * 2. Counter-based: Philox4x32-10 (Salmon et al., "Parallel Random Numbers:
+ *    As Easy as 1, 2, 3", SC'11). Draw i is a pure function of (key, i),
+ *    so jumping to any position is O(1).
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace rng_streams {
+
+/**
+ * @brief Map a 32-bit engine output onto [0, range) using one output per draw.
+ *
+ * std::uniform_int_distribution is implementation-defined (libstdc++ and libc++
+ * give different sequences) and may consume a variable number of engine outputs
+ * per draw. Both break stream splitting, so we use a fixed multiply-shift
+ * mapping instead: draw i always uses exactly engine output i.
+ */
+inline std::uint32_t bounded(std::uint32_t x, std::uint32_t range) {
+    return static_cast<std::uint32_t>((static_cast<std::uint64_t>(x) * range) >> 32);
+}
+
+/**
+ * @brief Sub-stream of a seeded std::mt19937, positioned by discard() in
+ *        O(first_draw) steps.
+ * @param seed       Seed of the logical (single-thread) stream.
+ * @param first_draw Index of the first draw this sub-stream should produce.
+ */
+inline std::mt19937 make_mt19937_stream(std::uint32_t seed, std::uint64_t first_draw) {
+    std::mt19937 engine(seed);
+    engine.discard(first_draw);
+    return engine;
+}
+
+/**
+ * @brief Philox4x32-10 counter-based engine.
+ *
+ * Satisfies UniformRandomBitGenerator, so it can be used anywhere std::mt19937
+ * can. The whole state is a 128-bit counter plus a 64-bit key, which is cheap
+ * to copy into each thread and never needs to be shared.
+ */
+class Philox4x32 {
+    public:
+        using result_type = std::uint32_t;
+
+        explicit Philox4x32(std::uint64_t seed = 0)
+            : key_{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)} {}
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            if (index_ == 4) {
+                block_ = block(counter_++, key_);
+                index_ = 0;
+            }
+            return block_[index_++];
+        }
+
+        // O(1) jump: position the stream at absolute draw 'draw_index'.
+        void seek(std::uint64_t draw_index) {
+            counter_ = draw_index / 4;
+            index_ = 4;
+            const auto skip = static_cast<unsigned>(draw_index % 4);
+            for (unsigned i = 0; i < skip; ++i) {
+                (*this)();
+            }
+        }
+
+        void discard(std::uint64_t n) {
+            seek(position() + n);
+        }
+
+        // Absolute index of the next draw.
+        std::uint64_t position() const {
+            return index_ == 4 ? counter_ * 4 : (counter_ - 1) * 4 + index_;
+        }
+
+        // The raw bijection: 10 rounds over a 128-bit counter block.
+        static std::array<std::uint32_t, 4> block(std::uint64_t counter,
+                                                  std::array<std::uint32_t, 2> key) {
+            std::array<std::uint32_t, 4> ctr{static_cast<std::uint32_t>(counter),
+                                             static_cast<std::uint32_t>(counter >> 32), 0, 0};
+            for (int round = 0; round < 10; ++round) {
+                if (round > 0) {
+                    key[0] += 0x9E3779B9u;
+                    key[1] += 0xBB67AE85u;
+                }
+                const std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53u) * ctr[0];
+                const std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57u) * ctr[2];
+                ctr = {static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+                       static_cast<std::uint32_t>(p1),
+                       static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+                       static_cast<std::uint32_t>(p0)};
+            }
+            return ctr;
+        }
+
+    private:
+        std::array<std::uint32_t, 2> key_;
+        std::uint64_t counter_ = 0;
+        std::array<std::uint32_t, 4> block_{};
+        unsigned index_ = 4; // 4 == current block exhausted
+};
+
+/**
+ * @brief Counter-based sub-stream starting at absolute draw 'first_draw'.
+ */
+inline Philox4x32 make_philox_stream(std::uint64_t seed, std::uint64_t first_draw) {
+    Philox4x32 engine(seed);
+    engine.seek(first_draw);
+    return engine;
+}
+
+/**
+ * @brief First draw index of thread 'thread_idx' when 'total' draws are split
+ *        into 'num_threads' contiguous chunks (remainder goes to the first threads).
+ */
+inline std::uint64_t chunk_begin(std::uint64_t total, unsigned num_threads, unsigned thread_idx) {
+    const std::uint64_t base = total / num_threads;
+    const std::uint64_t extra = total % num_threads;
+    return thread_idx * base + (thread_idx < extra ? thread_idx : extra);
+}
+
+} // namespace rng_streams
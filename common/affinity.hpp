@@ -0,0 +1,34 @@
+/**
+ * pin_current_thread - hard CPU affinity for the calling thread.
+ *
+ * Used by the partitioned cyclic executive (one pinned thread per core) and
+ * by step6-bench (two threads on the same or on different CPUs). Linux only;
+ * elsewhere there is no portable hard affinity and threads run unpinned.
+ */
+
+#pragma once
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace parallel {
+
+/**
+ * @brief Pin the calling thread to one CPU.
+ * @return false if pinning is unsupported here or the CPU is not available.
+ */
+inline bool pin_current_thread(unsigned cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu; // macOS / Windows: no portable hard affinity, run unpinned
+    return false;
+#endif
+}
+
+} // namespace parallel
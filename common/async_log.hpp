@@ -0,0 +1,268 @@
+/**
+ * async_log - asynchronous, allocation-free console logging.
+ *
+ * Producer threads never touch std::cout and never allocate. A call like
+ *
+ *     async_log::log("Philosopher {} GOT chopstick ID {}\n", id, cs);
+ *
+ * claims a preallocated, fixed-size slot in a bounded lock-free MPSC ring
+ * (Vyukov's sequence-numbered ring buffer), copies the format pointer and the
+ * raw argument values into it and publishes it. A background thread drains
+ * published slots in ring order, formats them into one buffer and writes the
+ * whole batch with a single fwrite(). With nothing to drain it parks on
+ * std::atomic::wait; a producer pays one fence and one load per record and
+ * only makes the notify call when the writer is parked, so an idle program
+ * costs no wake-ups.
+ *
+ * Ordering: slots are claimed with one atomic increment and drained strictly in
+ * claim order, so records from any one thread come out in the order they were
+ * logged (and records from different threads in the order they were claimed).
+ *
+ * Limits: the format string must outlive the logger (use a string literal);
+ * at most MAX_ARGS arguments; string arguments are copied into the slot and
+ * truncated to STRING_BYTES bytes in total. When the ring is full the producer
+ * yields until the writer frees a slot, so nothing is ever dropped.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace async_log {
+
+class Logger {
+    public:
+        static constexpr std::size_t MAX_ARGS = 6;
+        static constexpr std::size_t STRING_BYTES = 48;
+        static constexpr std::size_t CAPACITY = 4096;   // slots, power of two
+
+        Logger() : slots_(CAPACITY) {
+            for (std::size_t i = 0; i < CAPACITY; ++i) {
+                slots_[i].seq.store(i, std::memory_order_relaxed);
+            }
+            writer_ = std::thread(&Logger::writer_loop, this);
+        }
+
+        // Drains everything still queued before returning
+        ~Logger() {
+            stop_.store(true, std::memory_order_release);
+            wake_writer();
+            writer_.join();
+        }
+
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        template <typename... Args>
+        void log(const char* fmt, const Args&... args) {
+            static_assert(sizeof...(Args) <= MAX_ARGS, "too many log arguments");
+            Slot& slot = claim();
+            slot.fmt = fmt;
+            slot.nargs = 0;
+            slot.str_used = 0;
+            (store(slot, args), ...);
+            publish(slot);
+        }
+
+        // Blocks until every record logged so far has been written out
+        void flush() {
+            const std::size_t target = tail_.load(std::memory_order_acquire);
+            while (written_.load(std::memory_order_acquire) < target) {
+                std::this_thread::yield();
+            }
+        }
+
+        // Times a producer found the ring full and had to wait
+        std::uint64_t full_waits() const { return full_waits_.load(std::memory_order_relaxed); }
+
+    private:
+        enum class Kind : std::uint8_t { Int, UInt, Double, Str, Char, Bool };
+
+        struct Arg {
+            Kind kind;
+            union {
+                long long i;
+                unsigned long long u;
+                double d;
+                struct {
+                    std::uint16_t offset;
+                    std::uint16_t length;
+                } s;
+            };
+        };
+
+        struct alignas(64) Slot {
+            std::atomic<std::size_t> seq{0};
+            const char* fmt = nullptr;
+            std::uint8_t nargs = 0;
+            std::uint16_t str_used = 0;
+            Arg args[MAX_ARGS];
+            char strings[STRING_BYTES];
+        };
+
+        std::vector<Slot> slots_;
+        alignas(64) std::atomic<std::size_t> tail_{0};      // next slot to claim (producers)
+        alignas(64) std::size_t head_ = 0;                  // next slot to drain (writer only)
+        std::atomic<std::size_t> written_{0};
+        std::atomic<std::uint64_t> full_waits_{0};
+        std::atomic<bool> stop_{false};
+        std::atomic<bool> parked_{false};                   // writer is (about to be) waiting
+        std::thread writer_;
+
+        Slot& claim() {
+            std::size_t pos = tail_.load(std::memory_order_relaxed);
+            for (;;) {
+                Slot& slot = slots_[pos & (CAPACITY - 1)];
+                const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+                const auto dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (dif == 0) {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        return slot;
+                    }
+                } else if (dif < 0) {
+                    // Full: the writer has not freed this slot yet
+                    full_waits_.fetch_add(1, std::memory_order_relaxed);
+                    std::this_thread::yield();
+                    pos = tail_.load(std::memory_order_relaxed);
+                } else {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void publish(Slot& slot) {
+            const std::size_t pos = slot.seq.load(std::memory_order_relaxed);
+            slot.seq.store(pos + 1, std::memory_order_release);
+            wake_writer();
+        }
+
+        // Pairs with the fence in writer_loop(): either the writer sees our
+        // store before it parks, or we see parked_ and wake it
+        void wake_writer() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (parked_.load(std::memory_order_relaxed)) {
+                parked_.store(false, std::memory_order_relaxed);
+                parked_.notify_one();
+            }
+        }
+
+        template <typename T>
+        void store(Slot& slot, const T& value) {
+            Arg& a = slot.args[slot.nargs++];
+            if constexpr (std::is_same_v<T, bool>) {
+                a.kind = Kind::Bool;
+                a.u = value ? 1 : 0;
+            } else if constexpr (std::is_same_v<T, char>) {
+                a.kind = Kind::Char;
+                a.u = static_cast<unsigned char>(value);
+            } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                a.kind = Kind::Int;
+                a.i = value;
+            } else if constexpr (std::is_integral_v<T>) {
+                a.kind = Kind::UInt;
+                a.u = value;
+            } else if constexpr (std::is_floating_point_v<T>) {
+                a.kind = Kind::Double;
+                a.d = value;
+            } else {
+                // Anything convertible to a string view: copied, truncated to what fits
+                const std::string_view sv(value);
+                const std::size_t n = std::min(sv.size(), STRING_BYTES - slot.str_used);
+                std::memcpy(slot.strings + slot.str_used, sv.data(), n);
+                a.kind = Kind::Str;
+                a.s.offset = slot.str_used;
+                a.s.length = static_cast<std::uint16_t>(n);
+                slot.str_used = static_cast<std::uint16_t>(slot.str_used + n);
+            }
+        }
+
+        static void append(std::string& out, const Slot& slot, const Arg& a) {
+            char buf[32];
+            int n = 0;
+            switch (a.kind) {
+                case Kind::Int:    n = std::snprintf(buf, sizeof buf, "%lld", a.i); break;
+                case Kind::UInt:   n = std::snprintf(buf, sizeof buf, "%llu", a.u); break;
+                case Kind::Double: n = std::snprintf(buf, sizeof buf, "%g", a.d); break;
+                case Kind::Char:   buf[0] = static_cast<char>(a.u); n = 1; break;
+                case Kind::Bool:   out += a.u ? "true" : "false"; return;
+                case Kind::Str:    out.append(slot.strings + a.s.offset, a.s.length); return;
+            }
+            out.append(buf, static_cast<std::size_t>(n));
+        }
+
+        // Replace each "{}" in the format with the next argument
+        static void format(std::string& out, const Slot& slot) {
+            std::size_t next = 0;
+            for (const char* p = slot.fmt; *p != '\0'; ++p) {
+                if (p[0] == '{' && p[1] == '}' && next < slot.nargs) {
+                    append(out, slot, slot.args[next++]);
+                    ++p;
+                } else {
+                    out += *p;
+                }
+            }
+        }
+
+        void writer_loop() {
+            std::string batch;
+            batch.reserve(64 * 1024);
+            for (;;) {
+                const bool stopping = stop_.load(std::memory_order_acquire);
+                std::size_t drained = 0;
+                for (;;) {
+                    Slot& slot = slots_[head_ & (CAPACITY - 1)];
+                    if (slot.seq.load(std::memory_order_acquire) != head_ + 1) {
+                        break; // next record (in claim order) not published yet
+                    }
+                    format(batch, slot);
+                    slot.seq.store(head_ + CAPACITY, std::memory_order_release);
+                    ++head_;
+                    ++drained;
+                }
+                if (!batch.empty()) {
+                    std::fwrite(batch.data(), 1, batch.size(), stdout);
+                    std::fflush(stdout);
+                    batch.clear();
+                }
+                written_.store(head_, std::memory_order_release);
+                if (drained == 0) {
+                    if (stopping && head_ == tail_.load(std::memory_order_acquire)) {
+                        return;
+                    }
+                    // Idle: announce the park, then re-check before sleeping
+                    parked_.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    const bool ready = slots_[head_ & (CAPACITY - 1)].seq.load(std::memory_order_relaxed) == head_ + 1;
+                    if (!ready && !stop_.load(std::memory_order_relaxed)) {
+                        parked_.wait(true, std::memory_order_relaxed);
+                    }
+                    parked_.store(false, std::memory_order_relaxed);
+                }
+            }
+        }
+};
+
+/**
+ * @brief The process-wide logger, started on first use and drained at exit.
+ */
+inline Logger& logger() {
+    static Logger instance;
+    return instance;
+}
+
+template <typename... Args>
+void log(const char* fmt, const Args&... args) {
+    logger().log(fmt, args...);
+}
+
+} // namespace async_log
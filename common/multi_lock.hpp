@@ -0,0 +1,164 @@
+/**
+ * AtomicResourceSet - acquire several resources at once with a single CAS.
+ *
+ * Resource ownership is packed into 64-bit atomic bitmasks (bit i of word
+ * i / 64 is set while resource i is held). Resources that live in the same
+ * word are taken together with one compare-and-swap, so there is no
+ * hold-and-wait between them and therefore no deadlock. Resources spread over
+ * several words are taken word by word in ascending order, which is a
+ * resource hierarchy and is still deadlock-free.
+ *
+ * A thread whose CAS cannot succeed (some wanted bit is already set) sleeps
+ * futex-style with std::atomic::wait until the word changes. Each word keeps
+ * a waiter count so that release() only calls notify_all() when somebody is
+ * actually waiting.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+
+namespace parallel {
+
+class AtomicResourceSet {
+    public:
+        static constexpr std::size_t BITS = 64;
+
+        explicit AtomicResourceSet(std::size_t count)
+            : count_(count), words_(new Word[(count + BITS - 1) / BITS]) {}
+
+        std::size_t size() const { return count_; }
+
+        // Both resources, atomically when they share a word
+        void acquire(std::size_t a, std::size_t b) {
+            const std::size_t ids[] = {a, b};
+            acquire(ids);
+        }
+
+        void release(std::size_t a, std::size_t b) {
+            const std::size_t ids[] = {a, b};
+            release(ids);
+        }
+
+        bool try_acquire(std::size_t a, std::size_t b) {
+            if (word_of(a) == word_of(b)) {
+                return try_acquire_word(word_of(a), bit_of(a) | bit_of(b));
+            }
+            const std::size_t lo = a < b ? a : b;
+            const std::size_t hi = a < b ? b : a;
+            if (!try_acquire_word(word_of(lo), bit_of(lo))) {
+                return false;
+            }
+            if (!try_acquire_word(word_of(hi), bit_of(hi))) {
+                release_word(word_of(lo), bit_of(lo));
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Acquire every resource in 'ids' (any order, no duplicates).
+         * One CAS per distinct word, words taken in ascending order.
+         */
+        void acquire(std::span<const std::size_t> ids) {
+            for (std::size_t w = next_word(ids, 0); w != NONE; w = next_word(ids, w + 1)) {
+                acquire_word(w, mask_in(ids, w));
+            }
+        }
+
+        void release(std::span<const std::size_t> ids) {
+            for (std::size_t w = next_word(ids, 0); w != NONE; w = next_word(ids, w + 1)) {
+                release_word(w, mask_in(ids, w));
+            }
+        }
+
+        // Times a caller had to sleep because its CAS could not succeed
+        std::uint64_t waits() const { return waits_.load(std::memory_order_relaxed); }
+
+    private:
+        static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+        struct alignas(64) Word {
+            std::atomic<std::uint64_t> bits{0};
+            std::atomic<std::uint32_t> waiters{0};
+        };
+
+        std::size_t count_;
+        std::unique_ptr<Word[]> words_;
+        std::atomic<std::uint64_t> waits_{0};
+
+        static std::size_t word_of(std::size_t id) { return id / BITS; }
+        static std::uint64_t bit_of(std::size_t id) { return std::uint64_t{1} << (id % BITS); }
+
+        // Smallest word index >= 'from' touched by 'ids', or NONE
+        static std::size_t next_word(std::span<const std::size_t> ids, std::size_t from) {
+            std::size_t best = NONE;
+            for (std::size_t id : ids) {
+                const std::size_t w = word_of(id);
+                if (w >= from && w < best) {
+                    best = w;
+                }
+            }
+            return best;
+        }
+
+        static std::uint64_t mask_in(std::span<const std::size_t> ids, std::size_t word) {
+            std::uint64_t mask = 0;
+            for (std::size_t id : ids) {
+                if (word_of(id) == word) {
+                    mask |= bit_of(id);
+                }
+            }
+            return mask;
+        }
+
+        bool try_acquire_word(std::size_t w, std::uint64_t mask) {
+            std::uint64_t cur = words_[w].bits.load(std::memory_order_relaxed);
+            while ((cur & mask) == 0) {
+                if (words_[w].bits.compare_exchange_weak(cur, cur | mask, std::memory_order_acquire,
+                                                         std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void acquire_word(std::size_t w, std::uint64_t mask) {
+            Word& word = words_[w];
+            std::uint64_t cur = word.bits.load(std::memory_order_relaxed);
+            for (;;) {
+                if ((cur & mask) == 0) {
+                    if (word.bits.compare_exchange_weak(cur, cur | mask, std::memory_order_acquire,
+                                                        std::memory_order_relaxed)) {
+                        return;
+                    }
+                    continue; // 'cur' was refreshed by the failed CAS
+                }
+                // Announce ourselves before re-checking, so release() either sees
+                // the waiter or we see its cleared bits (both sides are seq_cst).
+                word.waiters.fetch_add(1, std::memory_order_seq_cst);
+                cur = word.bits.load(std::memory_order_seq_cst);
+                if (cur & mask) {
+                    waits_.fetch_add(1, std::memory_order_relaxed);
+                    word.bits.wait(cur, std::memory_order_relaxed);
+                }
+                word.waiters.fetch_sub(1, std::memory_order_relaxed);
+                cur = word.bits.load(std::memory_order_relaxed);
+            }
+        }
+
+        void release_word(std::size_t w, std::uint64_t mask) {
+            Word& word = words_[w];
+            word.bits.fetch_and(~mask, std::memory_order_seq_cst);
+            if (word.waiters.load(std::memory_order_seq_cst) != 0) {
+                word.bits.notify_all();
+            }
+        }
+};
+
+} // namespace parallel
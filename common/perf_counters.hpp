@@ -0,0 +1,327 @@
+/**
+ * perf_counters - hardware performance counters for a timed region.
+ *
+ *     {
+ *         perf::ScopedProfiler prof("threads");
+ *         ... run and join the threads ...
+ *     }   // prints: [perf] threads: wall 0.41 s, cpu 1.52 s, ... IPC 1.87, ...
+ *
+ * Per region it records wall time, CPU time (user + system) and voluntary /
+ * involuntary context switches from getrusage, and, through Linux
+ * perf_event_open, the counts of:
+ *   cycles, instructions        - together give IPC (instructions per cycle)
+ *   llc-misses                  - PERF_COUNT_HW_CACHE_MISSES (last-level cache
+ *                                 misses on x86, the nearest equivalent elsewhere)
+ *   branch-misses               - mispredicted branches
+ *   ctx-switches                - software event, needs no PMU
+ * Hardware events count user space only, which perf_event_paranoid=2 (the
+ * usual default) still allows. Each event is opened on its own, so a machine
+ * or container that refuses some of them (no PMU in a VM, perf_event_open
+ * blocked by seccomp) still gets the others; a count that could not be taken
+ * is -1 and the report falls back to getrusage and the clock. When the kernel
+ * multiplexes more events than there are counters, counts are scaled by
+ * time enabled / time running.
+ *
+ * Scope::Process counts every thread of the process, as RUSAGE_SELF does:
+ * each event is opened on every thread listed in /proc/self/task when the
+ * region starts (already running helpers such as the async_log writer
+ * included), with perf inherit for the threads they create. Counts of
+ * threads created in the region are added when they exit, so stop a region
+ * only after joining them. Scope::Thread counts the calling thread alone
+ * (RUSAGE_THREAD), for per-thread regions inside workers.
+ *
+ * stop() ends the region early and returns the Sample instead of printing it;
+ * format() turns a Sample into the one-line report. usage(scope) is the
+ * getrusage reading on its own, for benchmarks that need nothing else.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstdlib>
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace perf {
+
+enum class Scope { Process, Thread };
+
+enum Event : std::size_t { CYCLES, INSTRUCTIONS, LLC_MISSES, BRANCH_MISSES, CONTEXT_SWITCHES, EVENT_COUNT };
+
+inline constexpr const char* EVENT_NAMES[EVENT_COUNT] = {
+    "cycles", "instructions", "llc-misses", "branch-misses", "ctx-switches"};
+
+struct Sample {
+    double wall_s = 0.0;
+    double cpu_s = -1.0;        // user + system, -1 without getrusage
+    long nvcsw = -1;            // voluntary context switches (blocked / slept)
+    long nivcsw = -1;           // involuntary ones (preempted)
+    std::array<std::int64_t, EVENT_COUNT> counts{-1, -1, -1, -1, -1}; // -1 = not counted
+    std::string unavailable;    // why perf counters are missing, if any are
+
+    bool counted(Event e) const { return counts[e] >= 0; }
+
+    // Instructions per cycle, or -1 without both counters
+    double ipc() const {
+        return counted(CYCLES) && counted(INSTRUCTIONS) && counts[CYCLES] > 0
+            ? static_cast<double>(counts[INSTRUCTIONS]) / static_cast<double>(counts[CYCLES]) : -1.0;
+    }
+};
+
+// getrusage figures: CPU time (user + system) and context switches
+struct Usage {
+    double cpu_s = -1.0;        // -1 where getrusage (or RUSAGE_THREAD) is missing
+    long nvcsw = -1;
+    long nivcsw = -1;
+
+    // Difference between two readings; all -1 if either is missing
+    Usage operator-(const Usage& before) const {
+        if (cpu_s < 0.0 || before.cpu_s < 0.0) {
+            return {};
+        }
+        return {cpu_s - before.cpu_s, nvcsw - before.nvcsw, nivcsw - before.nivcsw};
+    }
+};
+
+/**
+ * @brief Resource usage so far of the calling thread (Scope::Thread, Linux
+ *        only) or of the whole process (Scope::Process, not on Windows).
+ */
+inline Usage usage(Scope scope) {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage ru{};
+#if defined(__linux__)
+    getrusage(scope == Scope::Thread ? RUSAGE_THREAD : RUSAGE_SELF, &ru);
+#else
+    if (scope == Scope::Thread) {
+        return {}; // no per-thread getrusage outside Linux
+    }
+    getrusage(RUSAGE_SELF, &ru);
+#endif
+    const auto seconds = [](const timeval& tv) {
+        return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) / 1e6;
+    };
+    return {seconds(ru.ru_utime) + seconds(ru.ru_stime), ru.ru_nvcsw, ru.ru_nivcsw};
+#else
+    (void)scope;
+    return {};
+#endif
+}
+
+// The perf_event_open file descriptors for one region (none off Linux)
+class Counters {
+    public:
+        explicit Counters(Scope scope) {
+#if defined(__linux__)
+            static constexpr std::pair<std::uint32_t, std::uint64_t> EVENTS[EVENT_COUNT] = {
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+                {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+                {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+            };
+            // The calling thread first, so its errors are the ones reported
+            std::vector<pid_t> tids{0};
+            if (scope == Scope::Process) {
+                other_threads(tids);
+            }
+            for (std::size_t e = 0; e < EVENT_COUNT; ++e) {
+                perf_event_attr attr{};
+                attr.size = sizeof(attr);
+                attr.type = EVENTS[e].first;
+                attr.config = EVENTS[e].second;
+                attr.disabled = 1;
+                attr.inherit = scope == Scope::Process ? 1 : 0;
+                // Switches happen in the kernel, so only hardware events exclude it
+                attr.exclude_kernel = attr.type == PERF_TYPE_HARDWARE ? 1 : 0;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+                for (const pid_t tid : tids) {
+                    const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, PERF_FLAG_FD_CLOEXEC));
+                    if (fd >= 0) {
+                        fds_[e].push_back(fd);
+                        continue;
+                    }
+                    if (tid != 0) {
+                        continue; // exited since the listing
+                    }
+                    if (error_.empty()) {
+                        error_ = std::string(EVENT_NAMES[e]) + ": " + std::strerror(errno);
+                    }
+                    break;
+                }
+            }
+#else
+            (void)scope;
+            error_ = "perf_event_open is Linux-only";
+#endif
+        }
+
+        ~Counters() {
+#if defined(__linux__)
+            for (const auto& fds : fds_) {
+                for (const int fd : fds) {
+                    close(fd);
+                }
+            }
+#endif
+        }
+
+        Counters(const Counters&) = delete;
+        Counters& operator=(const Counters&) = delete;
+
+        void start() {
+#if defined(__linux__)
+            for (const auto& fds : fds_) {
+                for (const int fd : fds) {
+                    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        // Disable and read every counter, scaled for multiplexing and summed
+        // over threads (-1 if not counted)
+        std::array<std::int64_t, EVENT_COUNT> stop() {
+            std::array<std::int64_t, EVENT_COUNT> counts{-1, -1, -1, -1, -1};
+#if defined(__linux__)
+            for (std::size_t e = 0; e < EVENT_COUNT; ++e) {
+                for (const int fd : fds_[e]) {
+                    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                }
+                for (const int fd : fds_[e]) {
+                    std::uint64_t v[3] = {}; // value, time enabled, time running
+                    if (read(fd, v, sizeof(v)) != static_cast<ssize_t>(sizeof(v)) || (v[2] == 0 && v[1] != 0)) {
+                        continue; // never got a hardware counter
+                    }
+                    const double scale = v[2] != 0 && v[2] < v[1] ? static_cast<double>(v[1]) / static_cast<double>(v[2]) : 1.0;
+                    counts[e] = std::max<std::int64_t>(counts[e], 0) + static_cast<std::int64_t>(static_cast<double>(v[0]) * scale);
+                }
+            }
+#endif
+            return counts;
+        }
+
+        // Empty if every event could be opened, otherwise why the first one could not
+        const std::string& error() const { return error_; }
+
+    private:
+        std::array<std::vector<int>, EVENT_COUNT> fds_;
+        std::string error_;
+
+#if defined(__linux__)
+        // Append the ids of every other thread of this process
+        static void other_threads(std::vector<pid_t>& tids) {
+            DIR* dir = opendir("/proc/self/task");
+            if (dir == nullptr) {
+                return;
+            }
+            const auto self = static_cast<pid_t>(syscall(SYS_gettid));
+            while (const dirent* entry = readdir(dir)) {
+                const auto tid = static_cast<pid_t>(std::atol(entry->d_name));
+                if (tid > 0 && tid != self) {
+                    tids.push_back(tid);
+                }
+            }
+            closedir(dir);
+        }
+#endif
+};
+
+/**
+ * @brief One-line report: clock and getrusage figures, then whichever counters were taken.
+ */
+inline std::string format(const std::string& label, const Sample& s) {
+    std::ostringstream out;
+    out << "[perf] " << label << ": wall " << std::fixed << std::setprecision(3) << s.wall_s << " s";
+    if (s.cpu_s >= 0.0) {
+        out << ", cpu " << s.cpu_s << " s, ctxsw " << s.nvcsw << " vol / " << s.nivcsw << " invol";
+    }
+    bool any = false;
+    for (std::size_t e = 0; e < EVENT_COUNT; ++e) {
+        if (!s.counted(static_cast<Event>(e))) {
+            continue;
+        }
+        out << (any ? ", " : " | ") << EVENT_NAMES[e] << ' ' << s.counts[e];
+        if (e == INSTRUCTIONS && s.ipc() >= 0.0) {
+            out << " (IPC " << std::setprecision(2) << s.ipc() << ')';
+        }
+        any = true;
+    }
+    if (!s.unavailable.empty()) {
+        out << " | " << (any ? "some counters unavailable" : "no perf counters") << " (" << s.unavailable << ')';
+    }
+    return out.str();
+}
+
+/**
+ * @brief Profile from construction to stop() or destruction. Unless stop()
+ *        was called, the destructor prints format(label, sample) to 'out'.
+ */
+class ScopedProfiler {
+    public:
+        explicit ScopedProfiler(std::string label, Scope scope = Scope::Process, std::ostream& out = std::cerr)
+            : label_(std::move(label)), scope_(scope), out_(out), counters_(scope) {
+            usage_ = usage(scope_);
+            start_ = std::chrono::steady_clock::now();
+            counters_.start();
+        }
+
+        ~ScopedProfiler() {
+            if (!stopped_) {
+                out_ << format(label_, stop()) << "\n";
+            }
+        }
+
+        ScopedProfiler(const ScopedProfiler&) = delete;
+        ScopedProfiler& operator=(const ScopedProfiler&) = delete;
+
+        Sample stop() {
+            Sample s;
+            s.counts = counters_.stop();
+            s.wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+            const Usage used = usage(scope_) - usage_;
+            s.cpu_s = used.cpu_s;
+            s.nvcsw = used.nvcsw;
+            s.nivcsw = used.nivcsw;
+            s.unavailable = counters_.error();
+            stopped_ = true;
+            return s;
+        }
+
+        const std::string& label() const { return label_; }
+
+    private:
+        std::string label_;
+        Scope scope_;
+        std::ostream& out_;
+        Counters counters_;
+        Usage usage_;
+        std::chrono::steady_clock::time_point start_;
+        bool stopped_ = false;
+};
+
+} // namespace perf
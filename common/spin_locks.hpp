@@ -0,0 +1,183 @@
+/**
+ * spin_locks - user-space locks for short critical sections.
+ *
+ * All three are BasicLockable, so they drop into std::lock_guard /
+ * std::unique_lock wherever a std::mutex guards a few instructions:
+ *   TtasSpinLock - test-and-test-and-set: waiters spin on a plain load (the
+ *                  line stays shared in their caches) and only try the
+ *                  exchange when the lock looks free. Cheapest uncontended;
+ *                  unfair, and every release makes all waiters race.
+ *   TicketLock   - take a ticket, wait until the serving counter reaches it. FIFO
+ *                  fair; every waiter still spins on the same line.
+ *   McsLock      - Mellor-Crummey & Scott queue lock: each waiter spins on a
+ *                  flag in its own queue node and the holder hands the lock
+ *                  straight to its successor. FIFO fair, and a release
+ *                  touches one other cache line however many threads wait.
+ *
+ * Spinning only pays while the holder is running. When there are more
+ * threads than CPUs the holder may be descheduled, so every spin loop yields
+ * the CPU after SPINS_BEFORE_YIELD failed checks instead of burning its slice.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h> // For _mm_pause
+#define PARALLEL_HAVE_PAUSE 1
+#endif
+
+namespace parallel {
+
+inline constexpr int SPINS_BEFORE_YIELD = 128;
+
+// Spin-wait hint for the core (and its hyper-thread sibling)
+inline void cpu_relax() {
+#if defined(PARALLEL_HAVE_PAUSE)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+// One failed check of a spin loop: pause, and yield every SPINS_BEFORE_YIELD calls
+inline void spin_backoff(int& spins) {
+    if (++spins < SPINS_BEFORE_YIELD) {
+        cpu_relax();
+    } else {
+        spins = 0;
+        std::this_thread::yield();
+    }
+}
+
+class TtasSpinLock {
+    public:
+        void lock() {
+            int spins = 0;
+            for (;;) {
+                if (!locked_.exchange(true, std::memory_order_acquire)) {
+                    return;
+                }
+                while (locked_.load(std::memory_order_relaxed)) {
+                    spin_backoff(spins);
+                }
+            }
+        }
+
+        bool try_lock() {
+            return !locked_.load(std::memory_order_relaxed)
+                && !locked_.exchange(true, std::memory_order_acquire);
+        }
+
+        void unlock() { locked_.store(false, std::memory_order_release); }
+
+    private:
+        alignas(64) std::atomic<bool> locked_{false};
+};
+
+class TicketLock {
+    public:
+        void lock() {
+            const std::uint32_t ticket = next_.fetch_add(1, std::memory_order_relaxed);
+            int spins = 0;
+            while (serving_.load(std::memory_order_acquire) != ticket) {
+                spin_backoff(spins);
+            }
+        }
+
+        void unlock() {
+            // Only the holder writes serving_, so a plain increment is enough
+            serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+
+    private:
+        alignas(64) std::atomic<std::uint32_t> next_{0};
+        alignas(64) std::atomic<std::uint32_t> serving_{0};
+};
+
+class McsLock {
+    public:
+        struct alignas(64) Node {
+            std::atomic<Node*> next{nullptr};
+            std::atomic<bool> waiting{false};
+        };
+
+        // Explicit-node interface: 'node' must stay alive until unlock(node)
+        void lock(Node& node) {
+            node.next.store(nullptr, std::memory_order_relaxed);
+            node.waiting.store(true, std::memory_order_relaxed);
+            Node* prev = tail_.exchange(&node, std::memory_order_acq_rel);
+            if (prev != nullptr) {
+                prev->next.store(&node, std::memory_order_release);
+                int spins = 0;
+                while (node.waiting.load(std::memory_order_acquire)) {
+                    spin_backoff(spins);
+                }
+            }
+        }
+
+        void unlock(Node& node) {
+            Node* next = node.next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                Node* expected = &node;
+                if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+                    return; // nobody queued behind us
+                }
+                // A successor swapped the tail but has not linked itself yet
+                int spins = 0;
+                while ((next = node.next.load(std::memory_order_acquire)) == nullptr) {
+                    spin_backoff(spins);
+                }
+            }
+            next->waiting.store(false, std::memory_order_release);
+        }
+
+        // BasicLockable interface: the node comes from a small per-thread pool
+        // and is remembered in holder_, which only the lock holder touches
+        void lock() {
+            Node& node = thread_nodes().acquire();
+            lock(node);
+            holder_ = &node;
+        }
+
+        void unlock() {
+            Node* node = holder_;
+            unlock(*node);
+            thread_nodes().release(*node);
+        }
+
+    private:
+        alignas(64) std::atomic<Node*> tail_{nullptr};
+        Node* holder_ = nullptr;
+
+        // Enough nodes for a thread to hold this many MCS locks at once
+        struct NodePool {
+            static constexpr int SIZE = 8;
+            Node nodes[SIZE];
+            std::uint32_t used = 0;
+
+            Node& acquire() {
+                for (int i = 0; i < SIZE; ++i) {
+                    if ((used & (1u << i)) == 0) {
+                        used |= 1u << i;
+                        return nodes[i];
+                    }
+                }
+                std::terminate(); // more than SIZE MCS locks held by one thread
+            }
+
+            void release(Node& node) { used &= ~(1u << (&node - nodes)); }
+        };
+
+        static NodePool& thread_nodes() {
+            thread_local NodePool pool;
+            return pool;
+        }
+};
+
+} // namespace parallel
@@ -0,0 +1,62 @@
+/**
+ * StripedCounter - a counter many threads can increment without contending.
+ *
+ * The count is split over several atomics, each on its own cache line; a
+ * thread always adds to the stripe it was assigned on first use (threads are
+ * dealt out round-robin), so with at least as many stripes as threads no two
+ * threads ever write the same line. Increments are a relaxed fetch_add on an
+ * uncontended line. Reading the value sums the stripes, so it costs one load
+ * per stripe, and it is only exact once the writers have stopped (a read
+ * concurrent with increments sees some of them).
+ *
+ * Use it for hot statistics counters that are written far more often than
+ * read; where the exact value is needed at every step, use one atomic.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+#include "parallel_reduce.hpp"
+
+namespace parallel {
+
+class StripedCounter {
+    public:
+        explicit StripedCounter(std::size_t stripes = std::max(1u, std::thread::hardware_concurrency()))
+            : size_(stripes == 0 ? 1 : stripes), stripes_(new Padded<std::atomic<long long>>[size_]) {
+            for (std::size_t i = 0; i < size_; ++i) {
+                stripes_[i].value.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        void add(long long v = 1) {
+            stripes_[stripe_of_this_thread() % size_].value.fetch_add(v, std::memory_order_relaxed);
+        }
+
+        long long value() const {
+            long long sum = 0;
+            for (std::size_t i = 0; i < size_; ++i) {
+                sum += stripes_[i].value.load(std::memory_order_relaxed);
+            }
+            return sum;
+        }
+
+        std::size_t stripes() const { return size_; }
+
+    private:
+        std::size_t size_;
+        std::unique_ptr<Padded<std::atomic<long long>>[]> stripes_;
+
+        static std::size_t stripe_of_this_thread() {
+            static std::atomic<std::size_t> next{0};
+            thread_local const std::size_t mine = next.fetch_add(1, std::memory_order_relaxed);
+            return mine;
+        }
+};
+
+} // namespace parallel
@@ -0,0 +1,435 @@
+/**
+ * work_stealing_pool - a fixed set of worker threads instead of one thread per job.
+ *
+ * Creating and joining a std::thread costs tens of microseconds (a stack, a
+ * clone(), scheduler bookkeeping, teardown), which dwarfs a short job. The
+ * pool starts its workers once; submit() then only allocates one small job
+ * node and queues it:
+ *   - a job submitted from a worker goes on that worker's own Chase-Lev deque
+ *     (push/pop at the bottom without locks, LIFO for locality);
+ *   - a job submitted from any other thread goes on a shared injection queue;
+ *   - an idle worker takes from its own deque, then the injection queue, then
+ *     steals from the top of a random other worker's deque (FIFO, oldest
+ *     first), and parks on a futex-backed atomic wait when there is nothing.
+ *
+ * submit(f, args...) takes its arguments like the std::thread constructor
+ * (decay-copied, then invoked on a worker) and returns a TaskHandle<R>, which
+ * owns the job the way a std::thread owns its thread: it is move-only,
+ * get() waits and returns f's result (or rethrows its exception), detach()
+ * gives up the result. Unlike std::thread, destroying a handle that was never
+ * waited on does not terminate the program; it waits, like std::jthread.
+ * Calling get() from inside a pool job runs other jobs while it waits, so
+ * nested submit()/get() cannot deadlock the pool.
+ *
+ * Example:
+ *   parallel::WorkStealingPool pool(4);
+ *   auto h = pool.submit([](int x) { return x * 2; }, 21);
+ *   auto h2 = std::move(h);   // ownership moves, h is now empty
+ *   int v = h2.get();         // 42
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace parallel {
+
+namespace detail {
+
+// A queued job and the state its handle waits on; freed by whichever of the
+// two (worker, handle) lets go last
+struct JobBase {
+    std::atomic<std::uint32_t> done{0};
+    std::atomic<int> refs{2};
+    std::exception_ptr error;
+
+    virtual ~JobBase() = default;
+    virtual void run() noexcept = 0;
+
+    void finish() {
+        done.store(1, std::memory_order_release);
+        done.notify_all();
+    }
+
+    void release() {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+};
+
+template <typename R>
+struct JobResult : JobBase {
+    std::optional<R> value;
+};
+
+template <>
+struct JobResult<void> : JobBase {};
+
+template <typename R, typename F, typename... Args>
+struct Job final : JobResult<R> {
+    F fn;
+    std::tuple<Args...> args;
+
+    template <typename G, typename... A>
+    explicit Job(G&& g, A&&... a) : fn(std::forward<G>(g)), args(std::forward<A>(a)...) {}
+
+    void run() noexcept override {
+        try {
+            if constexpr (std::is_void_v<R>) {
+                std::apply(fn, std::move(args));
+            } else {
+                this->value.emplace(std::apply(fn, std::move(args)));
+            }
+        } catch (...) {
+            this->error = std::current_exception();
+        }
+        this->finish();
+    }
+};
+
+/**
+ * Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli, PPoPP 2013).
+ * The owner pushes and pops at the bottom; any thread steals from the top.
+ * The ring doubles when full; retired rings are kept until the deque dies,
+ * since a thief may still be reading one.
+ */
+class StealDeque {
+    public:
+        StealDeque() { rings_.push_back(std::make_unique<Ring>(64)); ring_.store(rings_.back().get()); }
+
+        StealDeque(const StealDeque&) = delete;
+        StealDeque& operator=(const StealDeque&) = delete;
+
+        // Owner only
+        void push(JobBase* job) {
+            const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+            const std::int64_t t = top_.load(std::memory_order_acquire);
+            Ring* r = ring_.load(std::memory_order_relaxed);
+            if (b - t > r->mask) {
+                r = grow(r, t, b);
+            }
+            r->put(b, job);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+
+        // Owner only; nullptr if empty
+        JobBase* pop() {
+            const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+            Ring* r = ring_.load(std::memory_order_relaxed);
+            bottom_.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t t = top_.load(std::memory_order_relaxed);
+            if (t > b) {
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            JobBase* job = r->get(b);
+            if (t == b) {
+                // Last job: race the thieves for it
+                if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                  std::memory_order_relaxed)) {
+                    job = nullptr;
+                }
+                bottom_.store(b + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        // Any thread; nullptr if empty or another thread won the race
+        JobBase* steal() {
+            std::int64_t t = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const std::int64_t b = bottom_.load(std::memory_order_acquire);
+            if (t >= b) {
+                return nullptr;
+            }
+            JobBase* job = ring_.load(std::memory_order_acquire)->get(t);
+            if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return job;
+        }
+
+    private:
+        struct Ring {
+            std::int64_t mask;
+            std::unique_ptr<std::atomic<JobBase*>[]> slots;
+
+            explicit Ring(std::int64_t size) : mask(size - 1), slots(new std::atomic<JobBase*>[static_cast<std::size_t>(size)]) {}
+            JobBase* get(std::int64_t i) const { return slots[static_cast<std::size_t>(i & mask)].load(std::memory_order_relaxed); }
+            void put(std::int64_t i, JobBase* j) { slots[static_cast<std::size_t>(i & mask)].store(j, std::memory_order_relaxed); }
+        };
+
+        alignas(64) std::atomic<std::int64_t> top_{0};
+        alignas(64) std::atomic<std::int64_t> bottom_{0};
+        std::atomic<Ring*> ring_{nullptr};
+        std::vector<std::unique_ptr<Ring>> rings_;  // owner only
+
+        Ring* grow(Ring* old, std::int64_t t, std::int64_t b) {
+            rings_.push_back(std::make_unique<Ring>((old->mask + 1) * 2));
+            Ring* bigger = rings_.back().get();
+            for (std::int64_t i = t; i < b; ++i) {
+                bigger->put(i, old->get(i));
+            }
+            ring_.store(bigger, std::memory_order_release);
+            return bigger;
+        }
+};
+
+} // namespace detail
+
+/**
+ * @brief Move-only owner of one submitted job's result.
+ */
+template <typename R>
+class TaskHandle {
+    public:
+        TaskHandle() = default;
+
+        TaskHandle(TaskHandle&& o) noexcept : job_(std::exchange(o.job_, nullptr)), help_(o.help_) {}
+
+        TaskHandle& operator=(TaskHandle&& o) noexcept {
+            if (this != &o) {
+                reset();
+                job_ = std::exchange(o.job_, nullptr);
+                help_ = o.help_;
+            }
+            return *this;
+        }
+
+        TaskHandle(const TaskHandle&) = delete;
+        TaskHandle& operator=(const TaskHandle&) = delete;
+
+        ~TaskHandle() { reset(); }
+
+        // True while the handle owns a job (cf. std::thread::joinable)
+        bool valid() const { return job_ != nullptr; }
+
+        bool ready() const { return job_ != nullptr && job_->done.load(std::memory_order_acquire) != 0; }
+
+        /**
+         * @brief Wait for the job, then hand over its result (or rethrow its
+         *        exception). The handle is empty afterwards.
+         */
+        R get() {
+            wait();
+            detail::JobResult<R>* job = std::exchange(job_, nullptr);
+            const std::exception_ptr error = job->error;
+            if constexpr (std::is_void_v<R>) {
+                job->release();
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            } else {
+                std::optional<R> value = std::move(job->value);
+                job->release();
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+                return std::move(*value);
+            }
+        }
+
+        void wait() const {
+            if (job_ == nullptr) {
+                return;
+            }
+            if (help_ != nullptr) {
+                help_(job_); // on a worker: keep running jobs until ours is done
+            }
+            while (job_->done.load(std::memory_order_acquire) == 0) {
+                job_->done.wait(0, std::memory_order_acquire);
+            }
+        }
+
+        // Let the job run on without anyone waiting for it (cf. std::thread::detach)
+        void detach() {
+            if (job_ != nullptr) {
+                std::exchange(job_, nullptr)->release();
+            }
+        }
+
+    private:
+        friend class WorkStealingPool;
+
+        detail::JobResult<R>* job_ = nullptr;
+        void (*help_)(detail::JobBase*) = nullptr;
+
+        TaskHandle(detail::JobResult<R>* job, void (*help)(detail::JobBase*)) : job_(job), help_(help) {}
+
+        void reset() {
+            if (job_ != nullptr) {
+                wait();
+                std::exchange(job_, nullptr)->release();
+            }
+        }
+};
+
+class WorkStealingPool {
+    public:
+        explicit WorkStealingPool(unsigned threads = std::max(1u, std::thread::hardware_concurrency()))
+            : deques_(std::max(threads, 1u)) {
+            for (unsigned i = 0; i < deques_.size(); ++i) {
+                workers_.emplace_back(&WorkStealingPool::worker_loop, this, i);
+            }
+        }
+
+        // Runs every job already submitted, then joins the workers
+        ~WorkStealingPool() {
+            while (pending_.load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+            stop_.store(true, std::memory_order_release);
+            wake(true);
+            for (auto& w : workers_) {
+                w.join();
+            }
+        }
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        unsigned size() const { return static_cast<unsigned>(workers_.size()); }
+
+        // Jobs taken from another worker's deque so far
+        std::uint64_t steals() const { return steals_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Queue f(args...) and return the handle that owns its result.
+         *        Arguments are decay-copied, as by the std::thread constructor.
+         */
+        template <typename F, typename... Args>
+        auto submit(F&& f, Args&&... args)
+            -> TaskHandle<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
+            using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+            auto* job = new detail::Job<R, std::decay_t<F>, std::decay_t<Args>...>(
+                std::forward<F>(f), std::forward<Args>(args)...);
+            pending_.fetch_add(1, std::memory_order_relaxed);
+
+            if (current_pool == this) {
+                deques_[current_worker].push(job);
+            } else {
+                std::lock_guard<std::mutex> lock(inject_m_);
+                inject_.push_back(job);
+            }
+            wake(false);
+            return TaskHandle<R>(job, &WorkStealingPool::help_until_done);
+        }
+
+    private:
+        std::vector<detail::StealDeque> deques_;
+        std::vector<std::thread> workers_;
+        std::mutex inject_m_;
+        std::deque<detail::JobBase*> inject_;       // jobs from non-worker threads
+        std::atomic<std::uint32_t> epoch_{0};       // bumped on every submit; idle workers wait on it
+        std::atomic<unsigned> sleepers_{0};
+        std::atomic<std::uint64_t> pending_{0};
+        std::atomic<std::uint64_t> steals_{0};
+        std::atomic<bool> stop_{false};
+
+        inline static thread_local WorkStealingPool* current_pool = nullptr;
+        inline static thread_local unsigned current_worker = 0;
+
+        void wake(bool all) {
+            epoch_.fetch_add(1, std::memory_order_seq_cst);
+            if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+                all ? epoch_.notify_all() : epoch_.notify_one();
+            }
+        }
+
+        detail::JobBase* find_job(unsigned self) {
+            if (detail::JobBase* job = deques_[self].pop()) {
+                return job;
+            }
+            {
+                std::lock_guard<std::mutex> lock(inject_m_);
+                if (!inject_.empty()) {
+                    detail::JobBase* job = inject_.front();
+                    inject_.pop_front();
+                    return job;
+                }
+            }
+            // Steal, starting from a different victim each time
+            thread_local std::uint32_t seed = 0x9e3779b9u * (self + 1);
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            const auto n = static_cast<unsigned>(deques_.size());
+            for (unsigned k = 0; k < n; ++k) {
+                const unsigned victim = (seed + k) % n;
+                if (victim == self) {
+                    continue;
+                }
+                if (detail::JobBase* job = deques_[victim].steal()) {
+                    steals_.fetch_add(1, std::memory_order_relaxed);
+                    return job;
+                }
+            }
+            return nullptr;
+        }
+
+        void execute(detail::JobBase* job) {
+            job->run();
+            job->release();
+            pending_.fetch_sub(1, std::memory_order_release);
+        }
+
+        // TaskHandle::wait() on a worker thread: run other jobs meanwhile
+        static void help_until_done(detail::JobBase* awaited) {
+            WorkStealingPool* self = current_pool;
+            if (self == nullptr) {
+                return;
+            }
+            while (awaited->done.load(std::memory_order_acquire) == 0) {
+                if (detail::JobBase* job = self->find_job(current_worker)) {
+                    self->execute(job);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        void worker_loop(unsigned self) {
+            current_pool = this;
+            current_worker = self;
+            for (;;) {
+                if (detail::JobBase* job = find_job(self)) {
+                    execute(job);
+                    continue;
+                }
+                // Announce we are about to sleep, then look once more, so a
+                // submit either sees the sleeper or its job is seen here
+                sleepers_.fetch_add(1, std::memory_order_seq_cst);
+                const std::uint32_t e = epoch_.load(std::memory_order_seq_cst);
+                detail::JobBase* job = find_job(self);
+                if (job == nullptr && !stop_.load(std::memory_order_acquire)) {
+                    epoch_.wait(e, std::memory_order_seq_cst);
+                }
+                sleepers_.fetch_sub(1, std::memory_order_relaxed);
+                if (job != nullptr) {
+                    execute(job);
+                } else if (stop_.load(std::memory_order_acquire)) {
+                    return;
+                }
+            }
+        }
+};
+
+} // namespace parallel